@@ -14,7 +14,9 @@
 #include "AudioLogger.h"
 #include "AudioTools/CoreAudio/AudioTypes.h"
 #include "AudioTools/CoreAudio/AudioOutput.h"
+#include "FastMath.h"
 #include <stdint.h>
+#include <atomic>
 
 namespace audio_tools {
 
@@ -35,6 +37,30 @@ public:
   /// determines if the effect is active
   virtual bool active() { return active_flag; }
 
+  /// processes a block of interleaved frames: by default all channels of a
+  /// frame are combined into one sample which is written back to each channel
+  virtual void processBlock(effect_t *data, int frames, int channels) {
+    for (int j = 0; j < frames; j++) {
+      effect_t *frame = data + (j * channels);
+      effect_t sample = 0;
+      for (int ch = 0; ch < channels; ch++) {
+        sample += frame[ch] / channels;
+      }
+      sample = process(sample);
+      for (int ch = 0; ch < channels; ch++) {
+        frame[ch] = sample;
+      }
+    }
+  }
+
+  /// re-initializes the state of the signal path e.g. when the audio resumes after
+  /// silence: called on the audio core
+  virtual void resetState() {}
+
+  /// called on the audio core instead of processBlock() while the effect is inactive or the
+  /// chain is bypassed (idle): e.g. to drain an input which runs in lockstep with the blocks
+  virtual void bypassBlock(int frames) {}
+
   virtual AudioEffect *clone() = 0;
 
   /// Allows to identify an effect
@@ -66,6 +92,68 @@ protected:
   }
 };
 
+/**
+ * @brief Lock-free queue with a fixed capacity for exactly one producer (e.g.
+ * the audio core) and one consumer (e.g. the control core)
+ * @author W. Voigt
+ * @copyright GPLv3
+ */
+template <class T, int N> class SPSCQueue {
+public:
+  /// adds an entry: returns false if the queue is full
+  bool push(const T &value) {
+    uint32_t head = head_pos.load(std::memory_order_relaxed);
+    if (head - tail_pos.load(std::memory_order_acquire) >= N) return false;
+    values[head % N] = value;
+    head_pos.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// removes the oldest entry: returns false if the queue is empty
+  bool pop(T &value) {
+    uint32_t tail = tail_pos.load(std::memory_order_relaxed);
+    if (tail == head_pos.load(std::memory_order_acquire)) return false;
+    value = values[tail % N];
+    tail_pos.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// producer: the free entry which is written in place before commit(), nullptr if full
+  T *claim() {
+    uint32_t head = head_pos.load(std::memory_order_relaxed);
+    if (head - tail_pos.load(std::memory_order_acquire) >= N) return nullptr;
+    return &values[head % N];
+  }
+
+  /// producer: publishes the entry of claim()
+  void commit() {
+    head_pos.store(head_pos.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /// consumer: the oldest entry which is read in place before release(), nullptr if empty
+  T *front() {
+    uint32_t tail = tail_pos.load(std::memory_order_relaxed);
+    if (tail == head_pos.load(std::memory_order_acquire)) return nullptr;
+    return &values[tail % N];
+  }
+
+  /// consumer: frees the entry of front()
+  void release() {
+    tail_pos.store(tail_pos.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  /// number of entries which can be popped
+  int available() {
+    return head_pos.load(std::memory_order_acquire) -
+           tail_pos.load(std::memory_order_acquire);
+  }
+
+protected:
+  T values[N];
+  std::atomic<uint32_t> head_pos{0};
+  std::atomic<uint32_t> tail_pos{0};
+};
+
 /**
  * @brief Boost AudioEffect
  * @ingroup effects
@@ -456,6 +544,1068 @@ protected:
 };
 
 
+/**
+ * @brief ITU-R BS.1770 true-peak detector: the signal is oversampled 4x with
+ * the 48 tap polyphase FIR from Annex 2 and the absolute maximum of all
+ * channels and phases is provided for each frame of the block.
+ * The effect does not change the audio, so it can be used for metering or as
+ * detector source of a Compressor (see Compressor::setDetector()).
+ * Because the oversampling is expensive it is only calculated when active.
+ * The buffers are allocated by begin() (or the constructor) for the largest block,
+ * the audio core does not allocate: larger blocks are not analysed.
+ * @author W. Voigt
+ * @ingroup effects
+ * @copyright GPLv3
+ */
+class TruePeakDetector : public AudioEffect {
+public:
+  static const int taps = 12;   // taps per phase
+  static const int phases = 4;  // oversampling factor
+
+  TruePeakDetector(bool isActive = false, int maxFrames = 256, int maxChannels = 2) {
+    setActive(isActive);
+    begin(maxFrames, maxChannels);
+  }
+
+  TruePeakDetector(const TruePeakDetector &copy) = default;
+
+  void setActive(bool value) override {
+    if (value && !active_flag) resetMax();
+    active_flag = value;
+    block_frames = 0;
+  }
+
+  /// allocates the buffers for blocks of up to maxFrames (control core, before the audio starts)
+  void begin(int maxFrames, int maxChannels = 2) {
+    history.resize(maxChannels * (taps - 1 + maxFrames));
+    memset(history.data(), 0, history.size() * sizeof(float));
+    peak_values.resize(maxFrames);
+    max_frames = maxFrames;
+    max_channels = maxChannels;
+    block_frames = 0;
+  }
+
+  /// the audio passes unchanged
+  effect_t process(effect_t input) { return input; }
+
+  /// determines the true-peak of each frame of the block
+  void processBlock(effect_t *data, int frames, int channels) override {
+    if (!active() || frames > max_frames || channels > max_channels) {
+      block_frames = 0;
+      return;
+    }
+    float *p_peaks = peak_values.data();
+    for (int j = 0; j < frames; j++) {
+      p_peaks[j] = 0.0f;
+    }
+    for (int ch = 0; ch < channels; ch++) {
+      // history of (taps - 1) samples followed by the actual block
+      float *x = history.data() + ch * (taps - 1 + max_frames);
+      float *in = x + (taps - 1);
+      for (int j = 0; j < frames; j++) {
+        in[j] = data[j * channels + ch] * (1.0f / 32767.0f);
+      }
+      for (int j = 0; j < frames; j++) {
+        const float *w = x + j;
+        float peak = p_peaks[j];
+        for (int p = 0; p < phases; p++) {
+          const float *h = coefficients[p];
+          float sum = 0.0f;
+          for (int k = 0; k < taps; k++) {
+            sum += h[k] * w[k];
+          }
+          sum = fabsf(sum);
+          if (sum > peak) peak = sum;
+        }
+        p_peaks[j] = peak;
+      }
+      // keep the last samples for the next block
+      memmove(x, x + frames, (taps - 1) * sizeof(float));
+    }
+    float block_peak = 0.0f;
+    for (int j = 0; j < frames; j++) {
+      if (p_peaks[j] > block_peak) block_peak = p_peaks[j];
+    }
+    peak_value = block_peak;
+    if (block_peak > peak_max) peak_max = block_peak;
+    block_frames = frames;
+  }
+
+  /// true-peak (1.0 = full scale) of each frame of the last block
+  const float *peaks() { return peak_values.data(); }
+
+  /// number of frames provided by peaks(): 0 if not active or the block was too large
+  int frames() { return block_frames; }
+
+  /// largest block which is analysed
+  int maxFrames() { return max_frames; }
+
+  /// the peak of a frame describes the signal about this number of frames earlier
+  int latency() { return taps / 2; }
+
+  /// true-peak (1.0 = full scale) of the last block
+  float truePeak() { return peak_value; }
+
+  /// true-peak of the last block in dBTP
+  float truePeakDb() { return toDb(peak_value); }
+
+  /// highest true-peak since the last resetMax()
+  float maxTruePeak() { return peak_max; }
+
+  /// highest true-peak since the last resetMax() in dBTP
+  float maxTruePeakDb() { return toDb(peak_max); }
+
+  void resetMax() { peak_max = 0.0f; }
+
+  /// clears the history of the interpolation filter
+  void resetState() override {
+    memset(history.data(), 0, history.size() * sizeof(float));
+  }
+
+  TruePeakDetector *clone() { return new TruePeakDetector(*this); }
+
+protected:
+  // ITU-R BS.1770-4 Annex 2: phases of the 48 tap interpolation filter,
+  // the taps are stored in reversed order to calculate a forward dot product
+  const float coefficients[phases][taps] = {
+      {-0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f,
+       -0.1022949218750f, 0.9721679687500f, 0.1373291015625f, -0.0594482421875f,
+       0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f},
+      {-0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f,
+       -0.2003173828125f, 0.7797851562500f, 0.4650878906250f, -0.1665039062500f,
+       0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f},
+      {-0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f,
+       -0.1665039062500f, 0.4650878906250f, 0.7797851562500f, -0.2003173828125f,
+       0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f},
+      {0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f,
+       -0.0594482421875f, 0.1373291015625f, 0.9721679687500f, -0.1022949218750f,
+       0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f}};
+  Vector<float> history{0};
+  Vector<float> peak_values{0};
+  int max_frames = 0;
+  int max_channels = 0;
+  int block_frames = 0;
+  float peak_value = 0.0f;
+  float peak_max = 0.0f;
+
+  float toDb(float value) {
+    if (value <= 0.0f) return -100.0f;
+    return fast_linear_to_db(value);
+  }
+};
+
+/**
+ * @brief Delay of a few frames which aligns the audio with the peaks of a
+ * TruePeakDetector (look-ahead), the gain is applied to the delayed frame.
+ * The last frames are kept in a ring: a change of the delay crossfades from the
+ * old to the new delay over fade_frames, so there is neither a gap nor a jump.
+ * @author W. Voigt
+ * @ingroup effects
+ * @copyright GPLv3
+ */
+class LookaheadDelay {
+public:
+  static const int max_frames = 16;
+  static const int max_channels = 2;
+  static const int fade_frames = 64;
+
+  /// changes the delay at the start of a block: next is its first frame
+  void setFrames(int frames, const effect_t *next, int channels) {
+    if (frames > max_frames) frames = max_frames;
+    if (frames == length) return;
+    if (!isActive()) {
+      // the ring was not written without delay: it starts with the next frame
+      for (int j = 0; j < ring_size; j++) {
+        for (int ch = 0; ch < max_channels; ch++) ring[j][ch] = ch < channels ? next[ch] : 0;
+      }
+    }
+    old_length = length;
+    length = frames;
+    fade_left = fade_frames;
+  }
+
+  int frames() { return length; }
+
+  /// false if the frames pass without delay
+  bool isActive() { return length > 0 || fade_left > 0; }
+
+  /// replaces the frame by the delayed frame multiplied with the gain
+  void apply(effect_t *frame, int channels, float gain) {
+    if (!isActive()) {
+      for (int ch = 0; ch < channels; ch++) {
+        frame[ch] = gain * frame[ch];
+      }
+      return;
+    }
+    memcpy(ring[pos], frame, channels * sizeof(effect_t));
+    const effect_t *delayed = ring[(pos - length) & ring_mask];
+    if (fade_left > 0) {
+      const effect_t *old = ring[(pos - old_length) & ring_mask];
+      float weight = (float)fade_left-- / fade_frames; // of the old delay
+      for (int ch = 0; ch < channels; ch++) {
+        frame[ch] = gain * (delayed[ch] + weight * (old[ch] - delayed[ch]));
+      }
+    } else {
+      for (int ch = 0; ch < channels; ch++) {
+        frame[ch] = gain * delayed[ch];
+      }
+    }
+    pos = (pos + 1) & ring_mask;
+  }
+
+protected:
+  static const int ring_size = 32;  // power of 2 > max_frames
+  static const int ring_mask = ring_size - 1;
+  effect_t ring[ring_size][max_channels] = {{0}};
+  int length = 0;
+  int old_length = 0;
+  int fade_left = 0;
+  int pos = 0;  // next frame
+};
+
+/**
+ * @brief EBU R128 loudness meter with K-weighting (ITU-R BS.1770).
+ * The audio core only filters the block and accumulates the energy of 100 ms
+ * sub-blocks which are handed over in a lock-free queue. The momentary (400 ms),
+ * short-term (3 s) and the gated integrated loudness are calculated by update()
+ * on the control core. The effect does not change the audio.
+ * @author W. Voigt
+ * @ingroup effects
+ * @copyright GPLv3
+ */
+class LoudnessMeter : public AudioEffect {
+public:
+  static const int max_channels = 2;
+  static const int short_term_blocks = 30; // 3 s of 100 ms sub-blocks
+  static const int momentary_blocks = 4;   // 400 ms
+  static const int histogram_size = 750;   // 0.1 LU from -70 to +5 LUFS
+
+  LoudnessMeter(float sampleRate = 44100) { setSampleRate(sampleRate); }
+
+  LoudnessMeter(const LoudnessMeter &copy) : AudioEffect() {
+    copyParent((AudioEffect *)&copy);
+    setSampleRate(copy.sample_rate);
+  }
+
+  /// calculates the K-weighting filter coefficients for the sample rate
+  void setSampleRate(float sampleRate) {
+    sample_rate = sampleRate;
+    sub_block_frames = sampleRate / 10;
+    // stage 1: high shelf (head effects)
+    double f0 = 1681.974450955533, q = 0.7071752369554196;
+    double k = tan(M_PI * f0 / sampleRate);
+    double vh = pow(10.0, 3.999843853973347 / 20.0);
+    double vb = pow(vh, 0.4996667741545416);
+    double a0 = 1.0 + k / q + k * k;
+    shelf_b[0] = (vh + vb * k / q + k * k) / a0;
+    shelf_b[1] = 2.0 * (k * k - vh) / a0;
+    shelf_b[2] = (vh - vb * k / q + k * k) / a0;
+    shelf_a[0] = 2.0 * (k * k - 1.0) / a0;
+    shelf_a[1] = (1.0 - k / q + k * k) / a0;
+    // stage 2: RLB high pass
+    f0 = 38.13547087602444;
+    q = 0.5003270373238773;
+    k = tan(M_PI * f0 / sampleRate);
+    a0 = 1.0 + k / q + k * k;
+    highpass_a[0] = 2.0 * (k * k - 1.0) / a0;
+    highpass_a[1] = (1.0 - k / q + k * k) / a0;
+    reset();
+  }
+
+  /// resets the filters and all measurements
+  void reset() {
+    memset(state, 0, sizeof(state));
+    sub_block_sum = 0.0f;
+    sub_block_count = 0;
+    float value;
+    while (sub_blocks.pop(value)) {
+    }
+    memset(recent, 0, sizeof(recent));
+    recent_count = 0;
+    recent_pos = 0;
+    resetIntegrated();
+  }
+
+  /// clears the K-weighting filters only: the measurements are kept
+  void resetState() override { memset(state, 0, sizeof(state)); }
+
+  /// restarts the integrated loudness (control core)
+  void resetIntegrated() {
+    memset(histogram, 0, sizeof(histogram));
+    histogram_count = 0;
+  }
+
+  /// the audio passes unchanged
+  effect_t process(effect_t input) { return input; }
+
+  /// audio core: K-weighting and accumulation of the energy
+  void processBlock(effect_t *data, int frames, int channels) override {
+    if (channels > max_channels) channels = max_channels;
+    int pos = 0;
+    while (pos < frames) {
+      int len = frames - pos;
+      if (len > sub_block_frames - sub_block_count)
+        len = sub_block_frames - sub_block_count;
+      sub_block_sum += filter(data + pos * channels, len, channels);
+      sub_block_count += len;
+      pos += len;
+      if (sub_block_count >= sub_block_frames) {
+        // mean square of the sub-block: lost if the control core is too slow
+        sub_blocks.push(sub_block_sum / sub_block_count);
+        sub_block_sum = 0.0f;
+        sub_block_count = 0;
+      }
+    }
+  }
+
+  /// control core: evaluates the new sub-blocks and returns their number
+  int update() {
+    int result = 0;
+    float energy;
+    while (sub_blocks.pop(energy)) {
+      recent[recent_pos] = energy;
+      recent_pos = (recent_pos + 1) % short_term_blocks;
+      if (recent_count < short_term_blocks) recent_count++;
+      // gating blocks of 400 ms with 75% overlap
+      if (recent_count >= momentary_blocks) {
+        float block_energy = average(momentary_blocks);
+        int bin = histogramBin(block_energy);
+        if (bin >= 0) {
+          histogram[bin]++;
+          histogram_count++;
+        }
+        momentary_lufs = toLufs(block_energy);
+      }
+      result++;
+    }
+    if (result > 0 && recent_count >= short_term_blocks) {
+      short_term_lufs = toLufs(average(short_term_blocks));
+    }
+    return result;
+  }
+
+  /// loudness of the last 400 ms in LUFS
+  float momentary() { return momentary_lufs; }
+
+  /// loudness of the last 3 s in LUFS
+  float shortTerm() { return short_term_lufs; }
+
+  /// gated integrated loudness since the last resetIntegrated() in LUFS
+  float integrated() {
+    if (histogram_count == 0) return min_lufs;
+    // relative gate: 10 LU below the loudness of all blocks above -70 LUFS
+    double sum = 0.0;
+    for (int j = 0; j < histogram_size; j++) {
+      if (histogram[j] > 0) sum += histogram[j] * binEnergy(j);
+    }
+    float gate = toLufs(sum / histogram_count) - 10.0f;
+    int gate_bin = (gate - (-70.0f)) * 10.0f;
+    if (gate_bin < 0) gate_bin = 0;
+    sum = 0.0;
+    uint32_t count = 0;
+    for (int j = gate_bin; j < histogram_size; j++) {
+      if (histogram[j] > 0) {
+        sum += histogram[j] * binEnergy(j);
+        count += histogram[j];
+      }
+    }
+    if (count == 0) return min_lufs;
+    return toLufs(sum / count);
+  }
+
+  LoudnessMeter *clone() { return new LoudnessMeter(*this); }
+
+protected:
+  const float min_lufs = -100.0f;
+  float sample_rate;
+  int sub_block_frames;
+  float shelf_b[3], shelf_a[2], highpass_a[2];
+  float state[max_channels][4];
+  // audio core
+  float sub_block_sum = 0.0f;
+  int sub_block_count = 0;
+  SPSCQueue<float, 32> sub_blocks;
+  // control core
+  float recent[short_term_blocks];
+  int recent_count = 0;
+  int recent_pos = 0;
+  uint32_t histogram[histogram_size];
+  uint32_t histogram_count = 0;
+  float momentary_lufs = -100.0f;
+  float short_term_lufs = -100.0f;
+
+  /// filters the frames with the two biquads (transposed direct form II) and
+  /// returns the sum of squares of all channels
+  float filter(effect_t *data, int frames, int channels) {
+    float sum = 0.0f;
+    for (int ch = 0; ch < channels; ch++) {
+      float s1 = state[ch][0], s2 = state[ch][1];
+      float s3 = state[ch][2], s4 = state[ch][3];
+      for (int j = 0; j < frames; j++) {
+        float x = data[j * channels + ch] * (1.0f / 32767.0f);
+        float y = shelf_b[0] * x + s1;
+        s1 = shelf_b[1] * x - shelf_a[0] * y + s2;
+        s2 = shelf_b[2] * x - shelf_a[1] * y;
+        // high pass with b = {1, -2, 1}
+        float z = y + s3;
+        s3 = -2.0f * y - highpass_a[0] * z + s4;
+        s4 = y - highpass_a[1] * z;
+        sum += z * z;
+      }
+      state[ch][0] = s1;
+      state[ch][1] = s2;
+      state[ch][2] = s3;
+      state[ch][3] = s4;
+    }
+    return sum;
+  }
+
+  /// mean energy of the last n sub-blocks
+  float average(int n) {
+    float sum = 0.0f;
+    for (int j = 1; j <= n; j++) {
+      sum += recent[(recent_pos - j + short_term_blocks) % short_term_blocks];
+    }
+    return sum / n;
+  }
+
+  int histogramBin(float energy) {
+    float lufs = toLufs(energy);
+    if (lufs < -70.0f) return -1; // absolute gate
+    int bin = (lufs - (-70.0f)) * 10.0f;
+    return bin < histogram_size ? bin : histogram_size - 1;
+  }
+
+  double binEnergy(int bin) {
+    return fast_exp2(((-70.0f + (bin + 0.5f) / 10.0f) + 0.691f) * 0.332192809f); // log2(10) / 10
+  }
+
+  float toLufs(double energy) {
+    if (energy <= 0.0) return min_lufs;
+    return -0.691f + 3.01029996f * fast_log2(energy); // 10 * log10(2)
+  }
+};
+
+/// Statistics of one interval of the programme (see ProgrammeStatistics)
+struct ProgrammeInterval {
+  static const int bins = 24;         // gain reduction in 1 dB bins, the last bin: 23 dB and more
+  uint32_t frames = 0;
+  float peak = 0.0f;                  // normalized
+  float mean_square = 0.0f;           // normalized
+  uint16_t gain_reduction[bins] = {0}; // blocks per bin
+};
+
+/**
+ * @brief Programme statistics for a slow control loop on the control core (e.g. an
+ * adaptive threshold): the audio core only sums the squares, takes the peak and counts
+ * the gain reduction of each block in a histogram. Every interval the sums are handed
+ * over in a lock-free queue. The effect does not change the audio.
+ * @author W. Voigt
+ * @ingroup effects
+ * @copyright GPLv3
+ */
+class ProgrammeStatistics : public AudioEffect {
+public:
+  ProgrammeStatistics(float sampleRate = 44100, float intervalSeconds = 1.0f) {
+    interval_frames = sampleRate * intervalSeconds;
+  }
+
+  ProgrammeStatistics(const ProgrammeStatistics &copy) : AudioEffect() {
+    copyParent((AudioEffect *)&copy);
+    interval_frames = copy.interval_frames;
+  }
+
+  /// the audio passes unchanged
+  effect_t process(effect_t input) { return input; }
+
+  /// audio core: sum of squares and peak of the block
+  void processBlock(effect_t *data, int frames, int channels) override {
+    int count = frames * channels;
+    float sum = 0.0f;
+    int peak = 0;
+    for (int j = 0; j < count; j++) {
+      int value = data[j];
+      sum += (float)value * value;
+      value = value < 0 ? -value : value;
+      peak = value > peak ? value : peak;
+    }
+    if (peak > current.peak) current.peak = peak;
+    current.mean_square += sum / channels;
+    current.frames += frames;
+    if (current.frames >= interval_frames) {
+      current.peak *= 1.0f / 32767.0f;
+      current.mean_square *= 1.0f / (32767.0f * 32767.0f * current.frames);
+      // lost if the control core is too slow
+      intervals.push(current);
+      current = ProgrammeInterval();
+    }
+  }
+
+  /// audio core: gain reduction of the last block in dB (<= 0), e.g. Compressor::gainReductionDb()
+  void addGainReduction(float gainDb) {
+    int bin = -gainDb;
+    if (bin < 0) bin = 0;
+    else if (bin >= ProgrammeInterval::bins) bin = ProgrammeInterval::bins - 1;
+    current.gain_reduction[bin]++;
+  }
+
+  /// control core: the next complete interval
+  bool pop(ProgrammeInterval &interval) { return intervals.pop(interval); }
+
+  /// the interval before the silence is dropped
+  void resetState() override { current = ProgrammeInterval(); }
+
+  ProgrammeStatistics *clone() { return new ProgrammeStatistics(*this); }
+
+protected:
+  uint32_t interval_frames;
+  ProgrammeInterval current;
+  SPSCQueue<ProgrammeInterval, 8> intervals;
+};
+
+/**
+ * @brief Makeup gain which is applied in one multiply pass per block. The gain
+ * follows changes with a ramp over the block, so it can be changed by the
+ * control core at any time. With updateAuto() the gain slowly follows the
+ * difference between the measured loudness and the target loudness.
+ * @author W. Voigt
+ * @ingroup effects
+ * @copyright GPLv3
+ */
+class MakeupGain : public AudioEffect {
+public:
+  MakeupGain(float gainDb = 0.0f) { setGainDb(gainDb); }
+
+  MakeupGain(const MakeupGain &copy) = default;
+
+  /// defines the gain in dB (control core)
+  void setGainDb(float db) {
+    gain_db = db;
+    target_gain = fast_db_to_linear(db);
+  }
+
+  float gainDb() { return gain_db; }
+
+  /// defines the loudness for updateAuto() in LUFS and the max gain in dB
+  void setTarget(float targetLufs, float maxGainDb = 12.0f) {
+    target_lufs = targetLufs;
+    max_gain_db = maxGainDb;
+  }
+
+  float target() { return target_lufs; }
+
+  /// defines how fast updateAuto() changes the gain in dB per second
+  void setSlewRate(float dbPerSecond) { slew_db = dbPerSecond; }
+
+  /// control core: moves the gain towards the target for the loudness which was
+  /// measured before this effect (e.g. LoudnessMeter::shortTerm())
+  void updateAuto(float measuredLufs, float seconds) {
+    // no boost of silence or pauses
+    if (measuredLufs < target_lufs - 30.0f) return;
+    float db = target_lufs - measuredLufs;
+    if (db > max_gain_db) db = max_gain_db;
+    else if (db < -max_gain_db) db = -max_gain_db;
+    float step = slew_db * seconds;
+    if (db > gain_db + step) db = gain_db + step;
+    else if (db < gain_db - step) db = gain_db - step;
+    setGainDb(db);
+  }
+
+  effect_t process(effect_t input) {
+    if (!active())
+      return input;
+    return clip(target_gain * input);
+  }
+
+  /// applies the gain to all channels with a ramp to the new gain
+  void processBlock(effect_t *data, int frames, int channels) override {
+    if (frames <= 0) return;
+    float target = target_gain;
+    float step = (target - current_gain) / frames;
+    float gain = current_gain;
+    for (int j = 0; j < frames; j++) {
+      gain += step;
+      effect_t *frame = data + (j * channels);
+      for (int ch = 0; ch < channels; ch++) {
+        frame[ch] = clip(gain * frame[ch]);
+      }
+    }
+    current_gain = target;
+  }
+
+  MakeupGain *clone() { return new MakeupGain(*this); }
+
+protected:
+  float gain_db = 0.0f;
+  float target_gain = 1.0f;
+  float current_gain = 1.0f;
+  float target_lufs = -23.0f;
+  float max_gain_db = 12.0f;
+  float slew_db = 0.5f;
+};
+
+/**
+ * @brief Dynamics processor with downward expander, compressor and limiter.
+ * One envelope of the detector max(|L|,|R|) is calculated for the block, the
+ * gain curves of the three stages are derived from it and combined into one
+ * gain per frame, which is applied in one multiply pass. Like the Compressor the
+ * expander and compressor work with the linear values, the limiter keeps the
+ * instantaneous detector value below the ceiling. With a TruePeakDetector (see
+ * setDetector()) the limiter keeps the true-peaks below the ceiling.
+ * The setters publish a new Settings object with an atomic pointer, the audio core
+ * takes it at the start of a block and does not allocate.
+ * @author W. Voigt
+ * @ingroup effects
+ * @copyright GPLv3
+ */
+class DynamicsProcessor : public AudioEffect {
+public:
+  /// Fully derived coefficients: published as a whole to the audio core
+  struct Settings {
+    float attack_coeff = 1.0f, release_coeff = 1.0f, limiter_release_coeff = 1.0f;
+    float expander_threshold = 0.0f, expander_inverse = 1.0f, expander_exponent = 0.0f;
+    float compressor_threshold = 1.0f, compressor_ratio = 1.0f;
+    float limiter_ceiling = 1.0f;
+  };
+
+  DynamicsProcessor(float sampleRate = 44100) {
+    sample_rate = sampleRate;
+    setAttack(5);
+    setRelease(200);
+    setExpander(-60, 1);
+    setCompressor(-20, 1);
+    setLimiter(-1);
+  }
+
+  DynamicsProcessor(const DynamicsProcessor &copy) : AudioEffect(copy) {
+    sample_rate = copy.sample_rate;
+    slots[0] = *copy.p_published.load();
+    envelope = copy.envelope;
+    limiter_gain = copy.limiter_gain;
+    min_gain = copy.min_gain;
+    block_input = copy.block_input;
+    block_output = copy.block_output;
+    p_detector = copy.p_detector;
+    lookahead = copy.lookahead;
+  }
+
+  /// attack of the envelope in ms
+  void setAttack(float ms) {
+    Settings *p_edit = edit();
+    p_edit->attack_coeff = timeCoeff(ms);
+    publish(p_edit);
+  }
+
+  /// release of the envelope in ms
+  void setRelease(float ms) {
+    Settings *p_edit = edit();
+    p_edit->release_coeff = timeCoeff(ms);
+    publish(p_edit);
+  }
+
+  /// downward expander below the threshold (dBFS): ratio 1 = off, 2 = 1:2
+  void setExpander(float thresholdDb, float ratio) {
+    Settings *p_edit = edit();
+    p_edit->expander_threshold = toLinear(thresholdDb);
+    p_edit->expander_inverse = 1.0f / p_edit->expander_threshold;
+    p_edit->expander_exponent = ratio < 1 ? 0 : ratio - 1;
+    publish(p_edit);
+  }
+
+  /// compressor above the threshold (dBFS): ratio 1 = off
+  void setCompressor(float thresholdDb, float ratio) {
+    Settings *p_edit = edit();
+    p_edit->compressor_threshold = toLinear(thresholdDb);
+    p_edit->compressor_ratio = ratio < 1 ? 1 : ratio;
+    publish(p_edit);
+  }
+
+  /// compressor threshold as normalized value (1.0 = full scale)
+  void setCompressorThreshold(float value) {
+    Settings *p_edit = edit();
+    p_edit->compressor_threshold = value;
+    publish(p_edit);
+  }
+
+  /// compressor ratio: 1 = off
+  void setCompressorRatio(float ratio) {
+    Settings *p_edit = edit();
+    p_edit->compressor_ratio = ratio < 1 ? 1 : ratio;
+    publish(p_edit);
+  }
+
+  /// limiter ceiling in dBFS and release of the limiter in ms
+  void setLimiter(float ceilingDb, float releaseMs = 50) {
+    Settings *p_edit = edit();
+    p_edit->limiter_ceiling = toLinear(ceilingDb);
+    p_edit->limiter_release_coeff = timeCoeff(releaseMs);
+    publish(p_edit);
+  }
+
+  /// The limiter uses the true-peaks of the detector instead of the sample peaks (nullptr =
+  /// sample peaks). The detector must be added to the effects before this processor. The
+  /// audio is delayed by the latency of the detector, so that the gain meets the peaks.
+  void setDetector(TruePeakDetector *detector) { p_detector = detector; }
+
+  /// smallest gain of the last block in dB
+  float gainReductionDb() {
+    return min_gain > 0.0f ? fast_linear_to_db(min_gain) : -100.0f;
+  }
+
+  /// largest normalized peak of the last block
+  float inputPeak() { return block_input; }
+
+  /// largest normalized peak after the gain of the last block
+  float outputPeak() { return block_output; }
+
+  effect_t process(effect_t input) {
+    if (!active())
+      return input;
+    float detector = fabsf(input * (1.0f / 32767.0f));
+    return clip(gain(acquire(), detector, detector) * input);
+  }
+
+  /// the envelope and the gain of each frame, then one multiply pass per chunk
+  void processBlock(effect_t *data, int frames, int channels) override {
+    const Settings &act = acquire();
+    const float *true_peaks = nullptr;
+    if (p_detector != nullptr && p_detector->frames() == frames && channels <= LookaheadDelay::max_channels) {
+      true_peaks = p_detector->peaks();
+    }
+    if (frames > 0) lookahead.setFrames(true_peaks != nullptr ? p_detector->latency() : 0, data, channels);
+    float gains[gain_chunk];
+    float block_min = 1.0f, input_peak = 0.0f, output_peak = 0.0f;
+    for (int start = 0; start < frames; start += gain_chunk) {
+      int count = frames - start < gain_chunk ? frames - start : gain_chunk;
+      effect_t *chunk = data + (start * channels);
+      for (int j = 0; j < count; j++) {
+        effect_t *frame = chunk + (j * channels);
+        int32_t peak = 0;
+        for (int ch = 0; ch < channels; ch++) {
+          int32_t value = frame[ch] < 0 ? -frame[ch] : frame[ch];
+          if (value > peak) peak = value;
+        }
+        float detector = peak * (1.0f / 32767.0f);
+        float limited = true_peaks != nullptr ? true_peaks[start + j] : detector;
+        float g = gain(act, detector, limited);
+        if (g < block_min) block_min = g;
+        if (limited > input_peak) input_peak = limited;
+        if (g * limited > output_peak) output_peak = g * limited;
+        gains[j] = g;
+      }
+      for (int j = 0; j < count; j++) {
+        lookahead.apply(chunk + (j * channels), channels, gains[j]);
+      }
+    }
+    min_gain = block_min;
+    block_input = input_peak;
+    block_output = output_peak;
+  }
+
+  /// the next transient starts from the idle envelope
+  void resetState() override {
+    envelope = 0.0f;
+    limiter_gain = 1.0f;
+    min_gain = 1.0f;
+  }
+
+  DynamicsProcessor *clone() { return new DynamicsProcessor(*this); }
+
+protected:
+  static const int gain_chunk = 64;  // gains on the stack: nothing is allocated
+  float sample_rate;
+  // the setters copy the published settings into a free slot and publish it: a slot is only
+  // reused when it is neither published nor in use by the audio core (see AudioEffectCommon).
+  // One writer: all setters must be called from the same task (control core)
+  static const int slots_count = 3;  // published, in use by the audio core, edited
+  Settings slots[slots_count];
+  std::atomic<const Settings *> p_published{&slots[0]};
+  std::atomic<const Settings *> p_hazard{nullptr};
+  float envelope = 0.0f;
+  float limiter_gain = 1.0f;
+  float min_gain = 1.0f;
+  float block_input = 0.0f, block_output = 0.0f;
+  TruePeakDetector *p_detector = nullptr;
+  LookaheadDelay lookahead;
+
+  /// copy of the published settings in a free slot (control core)
+  Settings *edit() {
+    const Settings *p_active = p_published.load();
+    const Settings *p_in_use = p_hazard.load();
+    for (int j = 0; j < slots_count; j++) {
+      if (&slots[j] != p_active && &slots[j] != p_in_use) {
+        slots[j] = *p_active;
+        return &slots[j];
+      }
+    }
+    return &slots[0]; // not reached: there are more slots than readers
+  }
+
+  void publish(const Settings *p_edit) { p_published.store(p_edit); }
+
+  /// the settings for the next block (audio core)
+  const Settings &acquire() {
+    const Settings *p_current;
+    do {
+      p_current = p_published.load();
+      p_hazard.store(p_current);
+    } while (p_current != p_published.load());
+    return *p_current;
+  }
+
+  /// composite gain of the stages for the detector value: the limiter keeps the peak
+  /// (sample or true-peak) below the ceiling
+  float gain(const Settings &act, float detector, float peak) {
+    // shared envelope
+    if (detector > envelope) envelope += (detector - envelope) * act.attack_coeff;
+    else envelope += (detector - envelope) * act.release_coeff;
+
+    float result = 1.0f;
+    if (envelope < act.expander_threshold && act.expander_exponent > 0.0f) {
+      result = fast_pow(envelope * act.expander_inverse, act.expander_exponent);
+    } else if (envelope > act.compressor_threshold && act.compressor_ratio > 1.0f) {
+      float output = act.compressor_threshold + (envelope - act.compressor_threshold) / act.compressor_ratio;
+      result = output * fast_reciprocal(envelope);
+    }
+    // the limiter acts immediately and releases slowly
+    peak *= result;
+    float limit = peak > act.limiter_ceiling ? act.limiter_ceiling * fast_reciprocal(peak) : 1.0f;
+    if (limit < limiter_gain) limiter_gain = limit;
+    else limiter_gain += (1.0f - limiter_gain) * act.limiter_release_coeff;
+    if (limiter_gain > limit) limiter_gain = limit;
+    return result * limiter_gain;
+  }
+
+  float timeCoeff(float ms) {
+    float coeff = 1000.0f / (sample_rate * ms);
+    return coeff > 1.0f ? 1.0f : coeff;
+  }
+
+  float toLinear(float db) { return fast_db_to_linear(db); }
+};
+
+/**
+ * @brief Stereo parametric equalizer: cascade of up to 8 biquads (transposed
+ * direct form II). Left and right are processed together with the coefficients
+ * and states stored as structure of arrays. The coefficients are calculated on
+ * the control core (RBJ Audio EQ Cookbook) and the audio core interpolates
+ * them over one block to avoid zipper noise.
+ * @author W. Voigt
+ * @ingroup effects
+ * @copyright GPLv3
+ */
+class ParametricEQ : public AudioEffect {
+public:
+  static const int max_bands = 8;
+
+  enum FilterType { Off, Peak, LowShelf, HighShelf, LowPass, HighPass };
+
+  ParametricEQ(float sampleRate = 44100) {
+    sample_rate = sampleRate;
+    for (int j = 0; j < max_bands; j++) {
+      setUnity(target, j);
+      setUnity(current, j);
+    }
+  }
+
+  ParametricEQ(const ParametricEQ &copy) : AudioEffect(copy) {
+    sample_rate = copy.sample_rate;
+    target = copy.target;
+    current = copy.current;
+    bands = copy.bands;
+  }
+
+  /// defines a band (control core): frequency in Hz, gain in dB (Peak and shelves);
+  /// q must be positive, otherwise the coefficients are not finite
+  bool setBand(int band, FilterType type, float frequency, float gainDb = 0, float q = 0.707f) {
+    if (band < 0 || band >= max_bands || !(q > 0.0f)) return false;
+    seq.fetch_add(1); // odd: the audio core does not read the target
+    calculate(band, type, frequency, gainDb, q);
+    if (type != Off && band >= bands) bands = band + 1;
+    seq.fetch_add(1);
+    return true;
+  }
+
+  /// removes all bands: they ramp to unity over the next block and are no longer processed
+  void clearBands() {
+    seq.fetch_add(1);
+    for (int j = 0; j < max_bands; j++) setUnity(target, j);
+    bands = 0;
+    seq.fetch_add(1);
+  }
+
+  /// processes mono samples with the left channel
+  effect_t process(effect_t input) {
+    if (!active())
+      return input;
+    float x = input;
+    for (int b = 0; b < bands; b++) {
+      float y = current.b0[b] * x + state_s1[0][b];
+      state_s1[0][b] = current.b1[b] * x - current.a1[b] * y + state_s2[0][b];
+      state_s2[0][b] = current.b2[b] * x - current.a2[b] * y;
+      x = y;
+    }
+    return clip(x);
+  }
+
+  /// processes the block: left and right are filtered together
+  void processBlock(effect_t *data, int frames, int channels) override {
+    if (frames <= 0) return;
+    // pick up new coefficients which are not just being written
+    bool ramp = false;
+    Coefficients delta;
+    int n_bands = active_bands;
+    uint32_t start = seq.load();
+    if (start != seq_used && (start & 1) == 0) {
+      Coefficients next = target;
+      int next_bands = bands;
+      // the copy must not be reordered after the check
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if (seq.load() == start) {
+        seq_used = start;
+        // removed bands ramp to unity in this block
+        if (next_bands > n_bands) n_bands = next_bands;
+        active_bands = next_bands;
+        float scale = 1.0f / frames;
+        for (int b = 0; b < max_bands; b++) {
+          delta.b0[b] = (next.b0[b] - current.b0[b]) * scale;
+          delta.b1[b] = (next.b1[b] - current.b1[b]) * scale;
+          delta.b2[b] = (next.b2[b] - current.b2[b]) * scale;
+          delta.a1[b] = (next.a1[b] - current.a1[b]) * scale;
+          delta.a2[b] = (next.a2[b] - current.a2[b]) * scale;
+        }
+        end_coeff = next;
+        ramp = true;
+      }
+    }
+    int stereo = channels >= 2;
+    for (int j = 0; j < frames; j++) {
+      effect_t *frame = data + (j * channels);
+      float x[2] = {(float)frame[0], stereo ? (float)frame[1] : 0.0f};
+      if (ramp) {
+        for (int b = 0; b < n_bands; b++) {
+          current.b0[b] += delta.b0[b];
+          current.b1[b] += delta.b1[b];
+          current.b2[b] += delta.b2[b];
+          current.a1[b] += delta.a1[b];
+          current.a2[b] += delta.a2[b];
+        }
+      }
+      for (int b = 0; b < n_bands; b++) {
+        for (int ch = 0; ch < 2; ch++) {
+          float y = current.b0[b] * x[ch] + state_s1[ch][b];
+          state_s1[ch][b] = current.b1[b] * x[ch] - current.a1[b] * y + state_s2[ch][b];
+          state_s2[ch][b] = current.b2[b] * x[ch] - current.a2[b] * y;
+          x[ch] = y;
+        }
+      }
+      frame[0] = clip(x[0]);
+      if (stereo) frame[1] = clip(x[1]);
+    }
+    // avoid rounding errors of the ramp
+    if (ramp) {
+      current = end_coeff;
+      // a removed band starts from rest when it is defined again
+      for (int b = active_bands; b < n_bands; b++) {
+        state_s1[0][b] = state_s1[1][b] = 0.0f;
+        state_s2[0][b] = state_s2[1][b] = 0.0f;
+      }
+    }
+  }
+
+  /// clears the filter states
+  void resetState() override {
+    memset(state_s1, 0, sizeof(state_s1));
+    memset(state_s2, 0, sizeof(state_s2));
+  }
+
+  ParametricEQ *clone() { return new ParametricEQ(*this); }
+
+protected:
+  struct Coefficients {
+    float b0[max_bands], b1[max_bands], b2[max_bands];
+    float a1[max_bands], a2[max_bands];
+  };
+  float sample_rate;
+  // control core
+  Coefficients target;
+  int bands = 0;
+  std::atomic<uint32_t> seq{0};
+  // audio core
+  Coefficients current, end_coeff;
+  int active_bands = 0;
+  uint32_t seq_used = 0;
+  float state_s1[2][max_bands] = {{0}};
+  float state_s2[2][max_bands] = {{0}};
+
+  void setUnity(Coefficients &c, int b) {
+    c.b0[b] = 1.0f;
+    c.b1[b] = c.b2[b] = c.a1[b] = c.a2[b] = 0.0f;
+  }
+
+  /// RBJ Audio EQ Cookbook
+  void calculate(int band, FilterType type, float frequency, float gainDb, float q) {
+    if (type == Off || frequency <= 0 || frequency >= sample_rate / 2) {
+      setUnity(target, band);
+      return;
+    }
+    float a = fast_db_to_linear(gainDb / 2.0f);
+    float w0 = 2.0f * M_PI * frequency / sample_rate;
+    float cosw = cosf(w0);
+    float alpha = sinf(w0) / (2.0f * q);
+    float b0, b1, b2, a0, a1, a2;
+    switch (type) {
+    case Peak:
+      b0 = 1 + alpha * a;
+      b1 = -2 * cosw;
+      b2 = 1 - alpha * a;
+      a0 = 1 + alpha / a;
+      a1 = -2 * cosw;
+      a2 = 1 - alpha / a;
+      break;
+    case LowShelf: {
+      float sq = 2 * sqrtf(a) * alpha;
+      b0 = a * ((a + 1) - (a - 1) * cosw + sq);
+      b1 = 2 * a * ((a - 1) - (a + 1) * cosw);
+      b2 = a * ((a + 1) - (a - 1) * cosw - sq);
+      a0 = (a + 1) + (a - 1) * cosw + sq;
+      a1 = -2 * ((a - 1) + (a + 1) * cosw);
+      a2 = (a + 1) + (a - 1) * cosw - sq;
+    } break;
+    case HighShelf: {
+      float sq = 2 * sqrtf(a) * alpha;
+      b0 = a * ((a + 1) + (a - 1) * cosw + sq);
+      b1 = -2 * a * ((a - 1) + (a + 1) * cosw);
+      b2 = a * ((a + 1) + (a - 1) * cosw - sq);
+      a0 = (a + 1) - (a - 1) * cosw + sq;
+      a1 = 2 * ((a - 1) - (a + 1) * cosw);
+      a2 = (a + 1) - (a - 1) * cosw - sq;
+    } break;
+    case LowPass:
+      b0 = (1 - cosw) / 2;
+      b1 = 1 - cosw;
+      b2 = (1 - cosw) / 2;
+      a0 = 1 + alpha;
+      a1 = -2 * cosw;
+      a2 = 1 - alpha;
+      break;
+    default: // HighPass
+      b0 = (1 + cosw) / 2;
+      b1 = -(1 + cosw);
+      b2 = (1 + cosw) / 2;
+      a0 = 1 + alpha;
+      a1 = -2 * cosw;
+      a2 = 1 - alpha;
+      break;
+    }
+    target.b0[band] = b0 / a0;
+    target.b1[band] = b1 / a0;
+    target.b2[band] = b2 / a0;
+    target.a1[band] = a1 / a0;
+    target.a2[band] = a2 / a0;
+  }
+};
+
 /**
  * @brief Compressor inspired by https://github.com/YetAnotherElectronicsChannel/STM32_DSP_COMPRESSOR/blob/master/code/Src/main.c
  * @author Phil Schatzmann
@@ -469,12 +1619,34 @@ protected:
 bool Compressor_Stereo = true;
 bool Compressor_Active1 = false;
 bool Compressor_Active2 = false;
-float sampleArr[2];
+
+/// Fully derived coefficients of the Compressor: e.g. precalculated for a preset
+struct CompressorSettings {
+    float threshold = 0.5;      // normalized 0 - 1
+    float ratio = 50;
+    float attack_coeff = 1.0;
+    float release_coeff = 1.0;
+    float mix = 1.0;            // part of the compressed signal: 0 = dry - 1 = wet
+};
 
 class Compressor : public AudioEffect { 
 public:    
+    /// How the channels of a frame are combined into the detector value
+    enum StereoLink { LinkMax, LinkAverage, LinkRms, LinkMidSide };
+
     /// Copy Constructor
-    Compressor(const Compressor &copy) = default;
+    Compressor(const Compressor &copy) : AudioEffect(copy) {
+        sample_rate = copy.sample_rate;
+        current_gain = copy.current_gain;
+        settings = copy.settings;
+        p_detector = copy.p_detector;
+        link = copy.link;
+        side_gain = copy.side_gain;
+        lookahead = copy.lookahead;
+        p_key_stream = copy.p_key_stream;
+        key_channels = copy.key_channels;
+        slots[0] = *copy.p_settings.load();
+    }
 
     /// Default Constructor
     Compressor(float sampleRate = 44100, float attackMs=5, float releaseMs=200, float holdMs=10, 
@@ -485,41 +1657,118 @@ public:
         
         sample_rate = sampleRate; 
 	      current_gain = 1.0f;
-        ratio = compressionRatio;
-        setThreshold(thresholdPercent);
-        setAttack(attackMs);
-        setRelease(releaseMs);    
+        settings = calculateSettings(sampleRate, attackMs, releaseMs, thresholdPercent, compressionRatio);
+        slots[0] = settings;
+    }
+
+    /// Calculates the coefficients e.g. for a preset, which can be activated with setSettings()
+    static CompressorSettings calculateSettings(float sampleRate, float attackMs, float releaseMs, 
+                                                float thresholdPercent, float compressionRatio,
+                                                float mixPercent = 100){
+        CompressorSettings result;
+        result.mix = mixValue(mixPercent);
+        result.attack_coeff = timeCoeff(sampleRate, attackMs);
+        result.release_coeff = timeCoeff(sampleRate, releaseMs);
+        result.threshold = thresholdValue(thresholdPercent);
+        result.ratio = compressionRatio < 1 ? 1 : compressionRatio;
+        return result;
+    }
+
+    /// Activates precalculated coefficients with a pointer swap: the gain is crossfaded
+    /// over the next block. The settings must stay valid while they are in use!
+    /// nullptr = the values of the setters
+    void setSettings(const CompressorSettings *newSettings){
+        if (newSettings == nullptr) publish(settings);
+        else p_settings.store(newSettings);
+    }
+
+    /// Activates a copy of the coefficients: all values change in the same block (crossfaded),
+    /// e.g. for the result of calculateSettings(). The setters continue from these values.
+    void setSettings(const CompressorSettings &newSettings){
+        settings = newSettings;
+        publish(settings);
     }
 
     /// Defines the attack duration in ms
     void setAttack(float attack_ms){
-        float attack_samples = sample_rate * (attack_ms / 1000.0);
-        attack_coeff = 1.0 / attack_samples;
-        if (attack_coeff > 1.0) attack_coeff = 1.0;
-        else if (attack_coeff < 0.0) attack_coeff = 0.0;
+        settings.attack_coeff = timeCoeff(sample_rate, attack_ms);
+        publish(settings);
     }
 
     /// Defines the release duration in ms
     void setRelease(float release_ms){
-        float release_samples = sample_rate * (release_ms / 1000.0);    
-        release_coeff = 1.0 / release_samples;
-        if (release_coeff > 1.0) release_coeff = 1.0;
-        else if (release_coeff < 0.0) release_coeff = 0.0;
+        settings.release_coeff = timeCoeff(sample_rate, release_ms);
+        publish(settings);
     }
 
     /// Defines the threshold in dB
     void setThreshold(float thresholdPercent){
-        if (thresholdPercent > 99) thresholdPercent = 99;
-        else if (thresholdPercent < 1) thresholdPercent = 1;
-        threshold = -0.5 * log10(1 - thresholdPercent / 100);
-        if (threshold > 1) threshold = 1;
-        else if (threshold < 0) threshold = 0;
+        settings.threshold = thresholdValue(thresholdPercent);
+        publish(settings);
     }
 
     /// Defines the compression ratio from 1 to 200
     void setCompressionRatio(float compressionRatio){
         if (compressionRatio < 1) compressionRatio = 1;
-        ratio = compressionRatio;
+        settings.ratio = compressionRatio;
+        publish(settings);
+    }
+
+    /// Parallel compression: part of the compressed signal in % (100 = compressed only),
+    /// the rest is the dry signal
+    void setMix(float mixPercent){
+        settings.mix = mixValue(mixPercent);
+        publish(settings);
+    }
+
+    /// Uses the true-peaks of the detector instead of the sample peaks (nullptr = sample peaks).
+    /// The detector must be added to the effects before the compressor. The audio is delayed
+    /// by the latency of the detector (look-ahead), so that the gain meets the peaks.
+    void setDetector(TruePeakDetector *detector){
+        p_detector = detector;
+    }
+
+    /// Defines the stereo link of the detector: max(|L|,|R|), average of the absolutes,
+    /// RMS of the channels or max(|M|,|S| * sideGain). With other than 2 channels
+    /// LinkMidSide falls back to LinkMax.
+    void setStereoLink(StereoLink mode, float sideGain = 1.0f){
+        link = mode;
+        side_gain = sideGain;
+    }
+
+    StereoLink stereoLink() { return link; }
+
+    /// External key input (sidechain, e.g. ducking under an announcement): the key must share the
+    /// clock of the output (e.g. the ADC on the I2S port of the DAC). Each block reads exactly its
+    /// frames, chunk by chunk into a fixed buffer: they arrived while the previous blocks were
+    /// played, so the read does not wait longer than the output. While the compressor is inactive
+    /// or bypassed the key is read and discarded (bypassBlock()), so it stays aligned. When a read
+    /// returns short the rest of the chunk is detected from the programme. nullptr = internal detection.
+    void setKeyStream(Stream *key, int keyChannels = 2){
+        p_key_stream = key;
+        key_channels = keyChannels < 1 ? 1 : (keyChannels > max_key_channels ? max_key_channels : keyChannels);
+    }
+
+    /// Key block for the next processBlock() only: it is used in place. Frames beyond
+    /// keyFrames are detected from the programme. Has priority over the key stream.
+    void setKeyBlock(const effect_t *key, int keyFrames, int keyChannels = 2){
+        p_key_block = key;
+        key_block_frames = keyFrames;
+        key_block_channels = keyChannels;
+    }
+
+    /// frames which were detected from the programme because the key was missing
+    uint32_t keyFallbackFrames() { return key_fallback_frames; }
+
+    /// largest normalized detector value of the last block
+    float inputPeak() { return block_input; }
+
+    /// largest normalized detector value after the gain of the last block
+    float outputPeak() { return block_output; }
+
+    /// smallest gain of the last block in dB
+    float gainReductionDb() {
+        return block_gain > 0.0f ? fast_linear_to_db(block_gain) : -100.0f;
     }
 
     /// Processes the sample
@@ -528,51 +1777,321 @@ public:
           return input;
         return compress(input);
     }
+
+    /// Processes the block: in stereo mode the gain is applied to each channel
+    void processBlock(effect_t *data, int frames, int channels) override {
+        if (!Compressor_Stereo) {
+            AudioEffect::processBlock(data, frames, channels);
+            skipKey(frames);
+            p_key_block = nullptr;
+            return;
+        }
+        // crossfade from the old to the new settings over this block
+        const CompressorSettings *p_old = p_active_settings;
+        const CompressorSettings &act = acquire();
+        bool fade = p_old != p_active_settings && frames > 0;
+        float fade_step = fade ? 1.0f / frames : 0.0f;
+
+        const float *true_peaks = nullptr;
+        if (p_detector != nullptr && p_detector->frames() == frames) true_peaks = p_detector->peaks();
+        bool delayed = true_peaks != nullptr && channels <= LookaheadDelay::max_channels;
+        if (frames > 0) lookahead.setFrames(delayed ? p_detector->latency() : 0, data, channels);
+        // the detector values are calculated in chunks with one fused loop per link mode
+        float detector[detector_chunk];
+        float input_peak = 0.0f, output_peak = 0.0f, min_gain = 1.0f;
+        bool keyed = p_key_block != nullptr || p_key_stream != nullptr;
+        for (int start = 0; start < frames; start += detector_chunk) {
+            int count = frames - start < detector_chunk ? frames - start : detector_chunk;
+            effect_t *chunk = data + (start * channels);
+            const float *normalized = detector;
+            if (keyed) detectKey(chunk, start, count, channels, true_peaks, detector);
+            else if (true_peaks != nullptr) normalized = true_peaks + start;
+            else detect(chunk, count, channels, detector);
+            float peak = 0.0f;
+            for (int j = 0; j < count; j++) {
+                peak = normalized[j] > peak ? normalized[j] : peak;
+            }
+            if (!fade && peak <= act.threshold) {
+                // below the threshold the target gain is 1: only the release is left
+                if (peak > input_peak) input_peak = peak;
+                float gain = release(act, chunk, normalized, count, channels, peak, output_peak);
+                if (gain < min_gain) min_gain = gain;
+                continue;
+            }
+            for (int j = 0; j < count; j++) {
+                float target_gain = targetGain(act, normalized[j]);
+                float wet = act.mix;
+                if (fade) {
+                    float mix = (start + j + 1) * fade_step;
+                    target_gain = mix * target_gain + (1.0f - mix) * targetGain(*p_old, normalized[j]);
+                    wet = mix * wet + (1.0f - mix) * p_old->mix;
+                }
+                // parallel compression: dry + wet in the same multiply
+                float gain = 1.0f - wet * (1.0f - smoothGain(act, target_gain));
+                lookahead.apply(chunk + (j * channels), channels, gain);
+                if (normalized[j] > input_peak) input_peak = normalized[j];
+                if (gain * normalized[j] > output_peak) output_peak = gain * normalized[j];
+                if (gain < min_gain) min_gain = gain;
+            }
+        }
+        p_key_block = nullptr;
+        block_input = input_peak;
+        block_output = output_peak;
+        block_gain = min_gain;
+    }
     
+    /// the next transient starts without gain reduction
+    void resetState() override {
+        current_gain = 1.0f;
+        block_gain = 1.0f;
+        Compressor_Active1 = false;
+        Compressor_Active2 = false;
+    }
+
+    /// the key of the block is read and discarded: it stays in lockstep with the blocks
+    void bypassBlock(int frames) override {
+        skipKey(frames);
+    }
+
     Compressor *clone() { return new Compressor(*this); }
 
 protected:
 
-    float sample_rate, threshold, ratio, current_gain;
-    float attack_coeff, release_coeff;
+    float sample_rate, current_gain;
+    CompressorSettings settings;  // values of the setters: control core only
+    // the setters copy their values into a free slot and publish it: a slot is only reused when
+    // it is neither published nor in use by the audio core, which keeps the settings of the
+    // previous block for the crossfade. One writer as in the DynamicsProcessor
+    static const int slots_count = 4;  // published, in use, previous block, edited
+    CompressorSettings slots[slots_count];
+    std::atomic<const CompressorSettings*> p_settings{&slots[0]};
+    std::atomic<const CompressorSettings*> p_hazard[2] = {{nullptr}, {nullptr}}; // in use, previous block
+    const CompressorSettings *p_active_settings = &slots[0];  // audio core
+    TruePeakDetector *p_detector = nullptr;
+    StereoLink link = LinkMax;
+    float side_gain = 1.0f;
+    // look-ahead: the audio is delayed by the latency of the detector, so that the dry and
+    // the compressed part stay aligned
+    LookaheadDelay lookahead;
+    float block_input = 0.0f, block_output = 0.0f, block_gain = 1.0f;
+    static const int detector_chunk = 64;
+    // sidechain: one chunk of the key stream is read at a time
+    static const int max_key_channels = 2;
+    Stream *p_key_stream = nullptr;
+    int key_channels = 2;
+    effect_t key_buffer[detector_chunk * max_key_channels];
+    const effect_t *p_key_block = nullptr;
+    int key_block_frames = 0;
+    int key_block_channels = 2;
+    uint32_t key_fallback_frames = 0;
+
+    /// normalized detector values of the frames: the switch is outside of the loops,
+    /// so that each loop has no branches and can be vectorized
+    void detect(const effect_t *data, int frames, int channels, float *result){
+        const float scale = 1.0f / 32767.0f;
+        if (channels == 2) {
+            switch (link) {
+                case LinkAverage:
+                    for (int j = 0; j < frames; j++) 
+                        result[j] = (fabsf(data[2 * j]) + fabsf(data[2 * j + 1])) * (0.5f * scale);
+                    return;
+                case LinkRms:
+                    for (int j = 0; j < frames; j++) {
+                        float l = data[2 * j], r = data[2 * j + 1];
+                        result[j] = sqrtf((l * l + r * r) * 0.5f) * scale;
+                    }
+                    return;
+                case LinkMidSide: {
+                    float side_scale = 0.5f * side_gain * scale;
+                    for (int j = 0; j < frames; j++) {
+                        float l = data[2 * j], r = data[2 * j + 1];
+                        float mid = fabsf(l + r) * (0.5f * scale);
+                        float side = fabsf(l - r) * side_scale;
+                        result[j] = mid > side ? mid : side;
+                    }
+                    return;
+                }
+                default:
+                    for (int j = 0; j < frames; j++) {
+                        float l = fabsf(data[2 * j]), r = fabsf(data[2 * j + 1]);
+                        result[j] = (l > r ? l : r) * scale;
+                    }
+                    return;
+            }
+        }
+        // any number of channels
+        float inverse = 1.0f / channels;
+        for (int j = 0; j < frames; j++) {
+            const effect_t *frame = data + (j * channels);
+            float value = 0.0f;
+            for (int ch = 0; ch < channels; ch++) {
+                float sample = frame[ch];
+                if (link == LinkAverage) value += fabsf(sample) * inverse;
+                else if (link == LinkRms) value += sample * sample * inverse;
+                else if (fabsf(sample) > value) value = fabsf(sample);
+            }
+            if (link == LinkRms) value = sqrtf(value);
+            result[j] = value * scale;
+        }
+    }
+
+    /// detector values of a chunk from the key as far as it reaches: the rest falls back to the
+    /// true-peaks or the programme
+    void detectKey(const effect_t *chunk, int start, int count, int channels, const float *true_peaks, 
+                   float *result){
+        // the key stream is read in any case: it runs in lockstep with the blocks
+        int keyed = p_key_stream != nullptr ? readKey(count) : 0;
+        if (p_key_block != nullptr) {
+            keyed = key_block_frames - start;
+            keyed = keyed < 0 ? 0 : (keyed > count ? count : keyed);
+            if (keyed > 0) detect(p_key_block + (start * key_block_channels), keyed, key_block_channels, result);
+        } else if (keyed > 0) {
+            detect(key_buffer, keyed, key_channels, result);
+        }
+        if (keyed == count) return;
+        key_fallback_frames += count - keyed;
+        if (true_peaks != nullptr) memcpy(result + keyed, true_peaks + start + keyed, (count - keyed) * sizeof(float));
+        else detect(chunk + (keyed * channels), count - keyed, channels, result + keyed);
+    }
+
+    /// copies the values into a free slot and publishes it (control core)
+    void publish(const CompressorSettings &values){
+        // p_hazard[0] before p_hazard[1]: the audio core moves its settings from [0] to [1]
+        const CompressorSettings *p_published = p_settings.load();
+        const CompressorSettings *p_in_use = p_hazard[0].load();
+        const CompressorSettings *p_previous = p_hazard[1].load();
+        for (int j = 0; j < slots_count; j++) {
+            CompressorSettings *p_slot = &slots[j];
+            if (p_slot != p_published && p_slot != p_in_use && p_slot != p_previous) {
+                *p_slot = values;
+                p_settings.store(p_slot);
+                return;
+            }
+        }
+    }
+
+    /// the settings for the next block (audio core): the settings of the last block stay
+    /// protected, they are still used for the crossfade
+    const CompressorSettings &acquire(){
+        p_hazard[1].store(p_active_settings);
+        const CompressorSettings *p_current;
+        do {
+            p_current = p_settings.load();
+            p_hazard[0].store(p_current);
+        } while (p_current != p_settings.load());
+        p_active_settings = p_current;
+        return *p_current;
+    }
+
+    /// reads up to detector_chunk frames of the key stream into the key buffer: available() of
+    /// an I2S input does not report its DMA filling, the frames of the block are read anyway
+    int readKey(int frames){
+        int frame_size = key_channels * sizeof(effect_t);
+        return p_key_stream->readBytes((uint8_t*)key_buffer, frames * frame_size) / frame_size;
+    }
+
+    /// discards the frames of the key stream
+    void skipKey(int frames){
+        for (int start = 0; p_key_stream != nullptr && start < frames; start += detector_chunk) {
+            readKey(frames - start < detector_chunk ? frames - start : detector_chunk);
+        }
+    }
+
+    static float mixValue(float mixPercent){
+        if (mixPercent > 100) mixPercent = 100;
+        else if (mixPercent < 0) mixPercent = 0;
+        return mixPercent / 100.0f;
+    }
+
+    static float timeCoeff(float sampleRate, float ms){
+        float samples = sampleRate * (ms / 1000.0);
+        float coeff = 1.0 / samples;
+        if (coeff > 1.0) coeff = 1.0;
+        else if (coeff < 0.0) coeff = 0.0;
+        return coeff;
+    }
+
+    static float thresholdValue(float thresholdPercent){
+        if (thresholdPercent > 99) thresholdPercent = 99;
+        else if (thresholdPercent < 1) thresholdPercent = 1;
+        float threshold = -0.5f * 0.301029996f * fast_log2(1 - thresholdPercent / 100); // log10(2)
+        if (threshold > 1) threshold = 1;
+        else if (threshold < 0) threshold = 0;
+        return threshold;
+    }
 
     float compress(float inSampleF){
-        
-        float normalized_input = fabs(inSampleF / 32767.0);
+        const CompressorSettings &act = acquire();
+        float gain = smoothGain(act, targetGain(act, fabsf(inSampleF * (1.0f / 32767.0f))));
+        gain = 1.0f - act.mix * (1.0f - gain);
+        inSampleF = gain * inSampleF;
+        return inSampleF;
+    }
+
+    /// determines the gain for the normalized detector value
+    float targetGain(const CompressorSettings &act, float normalized_input){
         float normalized_output;
 
-        if (normalized_input <= threshold) {
+        if (normalized_input <= act.threshold) {
             // Below knee: no compression, output equals input
             normalized_output = normalized_input;
         } else {
             // Above knee: compression at the specified ratio
-            normalized_output = threshold + (normalized_input - threshold) / ratio;
+            normalized_output = act.threshold + (normalized_input - act.threshold) / act.ratio;
         }
         float target_gain;
         if (normalized_input <= 0) target_gain = 1.0;
-        else target_gain = normalized_output / normalized_input;
+        else target_gain = normalized_output * fast_reciprocal(normalized_input);
         if (target_gain > 1.0) target_gain = 1.0;
         else if (target_gain < 0.0) target_gain = 0.0; 
+        return target_gain;
+    }
 
-        // Smooth the gain with attack and release times
+    /// release towards the target gain 1 in closed form: 1 - g(n) = (1 - g(0)) * (1 - release_coeff)^n.
+    /// Nothing is calculated at unity gain. Returns the smallest gain of the frames.
+    float release(const CompressorSettings &act, effect_t *data, const float *normalized, int frames, 
+                  int channels, float peak, float &output_peak){
+        if (current_gain >= 1.0f) {
+            if (peak > output_peak) output_peak = peak;
+            for (int j = 0; j < frames && lookahead.isActive(); j++) {
+                lookahead.apply(data + (j * channels), channels, 1.0f);
+            }
+            return 1.0f;
+        }
+        float factor = 1.0f - act.release_coeff;
+        float distance = 1.0f - current_gain;
+        float first = 1.0f - act.mix * distance * factor;
+        for (int j = 0; j < frames; j++) {
+            distance *= factor;
+            // dry + wet * (1 - distance)
+            float gain = 1.0f - act.mix * distance;
+            lookahead.apply(data + (j * channels), channels, gain);
+            if (gain * normalized[j] > output_peak) output_peak = gain * normalized[j];
+        }
+        // below half an ulp of 1.0 the per sample release ends at exactly 1.0 as well
+        current_gain = distance < 6e-8f ? 1.0f : 1.0f - distance;
+        // the gain only rises: the flags of the last frame are the flags of the block
+        if (current_gain > 0.5) Compressor_Active2 = false;
+        if (current_gain > 0.9) Compressor_Active1 = false;
+        return first;
+    }
+
+    /// smoothes the gain with attack and release times
+    float smoothGain(const CompressorSettings &act, float target_gain){
         if (target_gain < current_gain) {
-            current_gain = current_gain + (target_gain - current_gain) * attack_coeff;            
+            current_gain = current_gain + (target_gain - current_gain) * act.attack_coeff;            
             if ((current_gain < 0.9) && (current_gain > 0.25)) Compressor_Active1 = true; // green
             else Compressor_Active1 = false;
             if  (current_gain < 0.5) Compressor_Active2 = true; // red 
             else Compressor_Active2 = false;
         } else { 
-            current_gain = current_gain + (target_gain - current_gain) * release_coeff;            
+            current_gain = current_gain + (target_gain - current_gain) * act.release_coeff;            
             if (current_gain > 0.5) Compressor_Active2 = false;
             if (current_gain > 0.9) Compressor_Active1 = false;
         }
         if (current_gain > 1.0) current_gain = 1.0;
         if (current_gain < 0.0) current_gain = 0.0;
-
-        sampleArr[0] = current_gain * sampleArr[0];
-        sampleArr[1] = current_gain * sampleArr[1];
-        inSampleF = current_gain * inSampleF;
-        return inSampleF;
+        return current_gain;
     }
 };
 
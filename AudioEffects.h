@@ -3,6 +3,7 @@
 #include "AudioTools/CoreAudio/AudioStreams.h"
 #include "SoundGenerator.h"
 #include "AudioEffect.h"
+#include <atomic>
 #if defined(USE_VARIANTS) && __cplusplus >= 201703L 
 #  include <variant>
 #endif
@@ -16,7 +17,104 @@
 namespace audio_tools {
 
 /**
- * Common functionality for managing a collection of effects
+ * @brief Immutable chain of effects with a prebuilt index by id. It is built and validated
+ * on the control core and then published to the audio core (see AudioEffectCommon).
+ * @author W. Voigt
+ * @copyright GPLv3
+*/
+
+class EffectGraph {
+    public:
+        static const int max_effects = 16;
+
+        /// Appends an effect: returns false if the graph is full
+        bool add(AudioEffect *effect){
+            if (effect==nullptr || count>=max_effects) return false;
+            effects[count++] = effect;
+            return true;
+        }
+
+        /// Removes an effect: returns false if it is not in the graph
+        bool remove(AudioEffect *effect){
+            for (int j=0;j<count;j++){
+                if (effects[j]==effect){
+                    for (int k=j+1;k<count;k++) effects[k-1] = effects[k];
+                    count--;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        void clear() {
+            count = 0;
+            buildIndex();
+        }
+
+        /// Checks that no effect is contained twice and that the ids are unique: builds the index
+        bool validate() {
+            for (int j=0;j<count;j++){
+                for (int k=j+1;k<count;k++){
+                    if (effects[j]==effects[k]) return false;
+                    if (effects[j]->id()!=-1 && effects[j]->id()==effects[k]->id()) return false;
+                }
+            }
+            buildIndex();
+            return true;
+        }
+
+        int size() {
+            return count;
+        }
+
+        AudioEffect* operator [](int idx){
+            return effects[idx];
+        }
+
+        /// Finds an effect by id with a binary search in the index
+        AudioEffect* find(int id){
+            int low = 0, high = count;
+            while (low < high){
+                int mid = (low + high) / 2;
+                if (index[mid].id <= id) low = mid + 1;
+                else high = mid;
+            }
+            // the last effect with the id
+            if (low > 0 && index[low-1].id == id) return index[low-1].effect;
+            return nullptr;
+        }
+
+    protected:
+        struct IndexEntry {
+            int id;
+            AudioEffect *effect;
+        };
+        AudioEffect *effects[max_effects];
+        IndexEntry index[max_effects];
+        int count = 0;
+
+        /// sorted by id, effects with the same id keep their order
+        void buildIndex() {
+            for (int j=0;j<count;j++){
+                IndexEntry entry{effects[j]->id(), effects[j]};
+                int k = j;
+                while (k > 0 && index[k-1].id > entry.id){
+                    index[k] = index[k-1];
+                    k--;
+                }
+                index[k] = entry;
+            }
+        }
+};
+
+/**
+ * Common functionality for managing a collection of effects.
+ * The control core builds a new EffectGraph in a preallocated slot and publishes it with an
+ * atomic pointer swap. The audio core calls acquire() at the start of each block and announces the
+ * graph which it is using: a slot is only reused when it is neither published nor in use (RCU).
+ * release() ends the block. The effects are owned by the caller: removeEffect() and clear() wait
+ * until the audio core has finished the block which may still use the old graph (grace period),
+ * so afterwards a removed effect can be deleted. They must not be called on the audio core.
  * @author Phil Schatzmann
  * @copyright GPLv3
 */
@@ -26,46 +124,107 @@ class AudioEffectCommon {
         /// Adds an effect object (by reference)
         void addEffect(AudioEffect &effect){
             TRACED();
-            effects.push_back(&effect);
+            addEffect(&effect);
         }
 
         /// Adds an effect using a pointer
         void addEffect(AudioEffect *effect){
             TRACED();
-            effects.push_back(effect);
+            EffectGraph *p_graph = edit();
+            if (p_graph==nullptr || !p_graph->add(effect) || !publish(p_graph)){
+                LOGE("addEffect failed");
+                return;
+            }
             LOGI("addEffect -> Number of effects: %d", (int)size());
         }
-        /// deletes all defined effects
+
+        /// Removes an effect from the chain: returns when the audio core does not use it any more
+        bool removeEffect(AudioEffect *effect){
+            TRACED();
+            EffectGraph *p_graph = edit();
+            if (p_graph==nullptr || !p_graph->remove(effect) || !publish(p_graph)) return false;
+            synchronize();
+            return true;
+        }
+
+        /// removes all defined effects: returns when the audio core does not use them any more
         void clear() {
             TRACED();
-            effects.clear();
+            EffectGraph *p_graph = edit();
+            if (p_graph==nullptr) return;
+            p_graph->clear();
+            publish(p_graph);
+            synchronize();
+        }
+
+        /// Provides a copy of the actual graph in a free slot to be changed and published (control core)
+        EffectGraph* edit() {
+            EffectGraph *p_active = p_published.load();
+            EffectGraph *p_in_use = p_hazard.load();
+            for (int j=0;j<slots;j++){
+                if (&graphs[j]!=p_active && &graphs[j]!=p_in_use){
+                    graphs[j] = *p_active;
+                    return &graphs[j];
+                }
+            }
+            return nullptr;
+        }
+
+        /// Validates the graph and activates it at the next block boundary (control core)
+        bool publish(EffectGraph *graph) {
+            if (!graph->validate()) {
+                LOGE("invalid effect graph");
+                return false;
+            }
+            p_published.store(graph);
+            return true;
+        }
+
+        /// Provides the graph for the next block (audio core): the block ends with release()
+        EffectGraph& acquire() {
+            epoch.fetch_add(1); // odd: in a block
+            EffectGraph *p_graph;
+            do {
+                p_graph = p_published.load();
+                p_hazard.store(p_graph);
+            } while (p_graph != p_published.load());
+            return *p_graph;
+        }
+
+        /// Ends the block: the effects of the graph are not used any more (audio core)
+        void release() {
+            epoch.fetch_add(1);
+        }
+
+        /// Waits until the audio core has finished the block which was running when the last graph
+        /// was published (control core): the next block uses the new graph
+        void synchronize() {
+            uint32_t start = epoch.load();
+            if ((start & 1) == 0) return; // between two blocks
+            while (epoch.load() == start) delay(1);
         }
 
         /// Provides the actual number of defined effects
         size_t size() {
-            return effects.size();
+            return p_published.load()->size();
         }
 
         /// Finds an effect by id
         AudioEffect* findEffect(int id){
-            // find AudioEffect
-            AudioEffect* result = nullptr;
-            for (int j=0;j<size();j++){
-                // we assume that ADSRGain is the first effect!
-                if (effects[j]->id()==id){
-                    result = effects[j];
-                }
-                LOGI("--> findEffect -> %d", effects[j]->id());
-            }
-            return result;
+            return p_published.load()->find(id);
         }
+
         /// gets an effect by index
         AudioEffect* operator [](int idx){
-            return effects[idx];
+            return (*p_published.load())[idx];
         }
 
     protected:
-        Vector<AudioEffect*> effects;
+        static const int slots = 3; // published, in use by the audio core, edited
+        EffectGraph graphs[slots];
+        std::atomic<EffectGraph*> p_published{&graphs[0]};
+        std::atomic<EffectGraph*> p_hazard{nullptr};
+        std::atomic<uint32_t> epoch{0}; // incremented at the start and the end of each block
 
 };
 
@@ -152,15 +311,18 @@ class AudioEffects : public SoundGenerator<effect_t> {
             effect_t sample;
             if (p_generator!=nullptr){
                 sample  = p_generator->readSample();
-                int size = effects.size();
+                EffectGraph &graph = effects.acquire();
+                int size = graph.size();
                 for (int j=0; j<size; j++){
-                    sample = effects[j]->process(sample);
+                    sample = graph[j]->process(sample);
                 }
+                effects.release();
             }
             return sample;
         }
 
-        /// deletes all defined effects
+        /// removes all defined effects: returns when the audio core does not use them any more;
+        /// they are owned by the caller, which may delete them afterwards
         void clear() {
             TRACED();
             effects.clear();
@@ -193,6 +355,91 @@ class AudioEffects : public SoundGenerator<effect_t> {
 };
 
 
+/**
+ * @brief Decimated tap of the audio before and after the effects, e.g. for a spectrum
+ * analyser on the control core. Every n blocks the audio core copies the mono mix of
+ * the next frames into a free slot of a lock-free queue until the slot has the frames
+ * of the analysis. Otherwise it costs one counter per block. If the control core is
+ * too slow the copy is skipped.
+ * @ingroup effects
+ * @author W. Voigt
+ * @copyright GPLv3
+*/
+class AudioTap {
+  public:
+    static const int max_frames = 1024;
+
+    struct Slot {
+        int16_t input[max_frames];  // before the effects
+        int16_t output[max_frames]; // after the effects
+    };
+
+    /// frames per slot (max 1024) and the distance of the copies in blocks
+    void begin(int frames, int everyBlocks){
+        slot_frames = frames > max_frames ? max_frames : frames;
+        every_blocks = everyBlocks < 1 ? 1 : everyBlocks;
+        countdown = every_blocks;
+        p_slot = nullptr;
+    }
+
+    int frames() {
+        return slot_frames;
+    }
+
+    /// audio core: block before the effects
+    void input(const int16_t *data, int frames, int channels){
+        if (p_slot == nullptr) {
+            if (slot_frames == 0 || --countdown > 0) return;
+            p_slot = slots.claim();
+            if (p_slot == nullptr) {
+                countdown = every_blocks;
+                return;
+            }
+            slot_pos = 0;
+        }
+        copy_frames = slot_frames - slot_pos < frames ? slot_frames - slot_pos : frames;
+        mix(data, channels, p_slot->input + slot_pos);
+    }
+
+    /// audio core: the same block after the effects
+    void output(const int16_t *data, int frames, int channels){
+        if (p_slot == nullptr) return;
+        mix(data, channels, p_slot->output + slot_pos);
+        slot_pos += copy_frames;
+        if (slot_pos >= slot_frames) {
+            slots.commit();
+            p_slot = nullptr;
+            countdown = every_blocks;
+        }
+    }
+
+    /// control core: the oldest complete slot or nullptr: call release() after use
+    const Slot *front() {
+        return slots.front();
+    }
+
+    void release() {
+        slots.release();
+    }
+
+  protected:
+    SPSCQueue<Slot, 2> slots;
+    Slot *p_slot = nullptr;
+    int slot_frames = 0;
+    int slot_pos = 0;
+    int copy_frames = 0;
+    int every_blocks = 1;
+    int countdown = 1;
+
+    void mix(const int16_t *data, int channels, int16_t *result){
+        if (channels == 2) {
+            for (int j = 0; j < copy_frames; j++) result[j] = (data[2 * j] + data[2 * j + 1]) / 2;
+            return;
+        }
+        for (int j = 0; j < copy_frames; j++) result[j] = data[j * channels];
+    }
+};
+
 /**
  * @brief EffectsStreamT: the template class describes an input or output stream to which one or multiple 
  * effects are applied. The number of channels are used to merge the samples of one frame into one sample
@@ -267,29 +514,28 @@ class AudioEffectStreamT : public ModifyingStream {
         size_t result = p_io->readBytes((uint8_t*)data, len);
         int frames = result / sizeof(T) / info.channels;
         T* samples = (T*) data;
+        if (idle_frames > 0 && updateIdle(samples, frames)) {
+            // bypass: the data is already in place
+            EffectGraph &graph = effects.acquire();
+            for (int j=0; j<graph.size(); j++) graph[j]->bypassBlock(frames);
+            effects.release();
+            process_time_us = 0;
+            return frames * info.channels * sizeof(T);
+        }
 
-        // process each channel separately (stereo) for Compressor only !  /Vo
-        // all other effects determine sample by combining all channels in frame
-        for (int count=0;count<frames;count++){
-            sampleArr[0] = sampleArr[1] = 0;  // global for Compressor
-            T result_sample = 0;
-            for (int ch=0;ch<info.channels;ch++){
-                T sample = *samples++;
-                result_sample += sample / info.channels; // combining all channels in frame for mono
-                sampleArr[ch] = sample;       // for Compressor only
-            }
-            // apply effects
-            for (int j=0; j<size(); j++){
-                result_sample = effects[j]->process(result_sample);
-            }
-            // write results to both channels
-            T* p_buffer = ((T*)data)+(count*info.channels);
-            for (int ch=0;ch<info.channels;ch++){
-                if (Compressor_Stereo) p_buffer[ch] = sampleArr[ch]; // from Compressor
-                else p_buffer[ch] = result_sample; // all other effects are mono
-                result_size += sizeof(T);
-            }
+        // apply the effects on the whole block: the Compressor processes each channel separately (stereo),
+        // all other effects determine the sample by combining all channels in frame  /Vo
+        uint32_t start = micros();
+        if (p_tap != nullptr) p_tap->input(samples, frames, info.channels);
+        EffectGraph &graph = effects.acquire();
+        for (int j=0; j<graph.size(); j++){
+            if (graph[j]->active()) graph[j]->processBlock(samples, frames, info.channels);
+            else graph[j]->bypassBlock(frames);
         }
+        effects.release();
+        if (p_tap != nullptr) p_tap->output(samples, frames, info.channels);
+        process_time_us = micros() - start;
+        result_size = frames * info.channels * sizeof(T);
         return result_size;
     }
 
@@ -303,6 +549,7 @@ class AudioEffectStreamT : public ModifyingStream {
         assert(len % (sizeof(T)*info.channels)==0);
         int frames = len / sizeof(T) / info.channels;
         size_t result_size = 0;
+        EffectGraph &graph = effects.acquire();
 
         // process all samples
         for (int j=0;j<frames;j++){
@@ -315,8 +562,8 @@ class AudioEffectStreamT : public ModifyingStream {
             }
 
             // apply effects
-            for (int j=0; j<size(); j++){
-                sample = effects[j]->process(sample);
+            for (int j=0; j<graph.size(); j++){
+                sample = graph[j]->process(sample);
             }
 
             // wite result channel times to output defined in constructor
@@ -329,6 +576,7 @@ class AudioEffectStreamT : public ModifyingStream {
                 }
             }
         }
+        effects.release();
         return result_size;
     }
 
@@ -356,7 +604,15 @@ class AudioEffectStreamT : public ModifyingStream {
         LOGI("addEffect -> Number of effects: %d", (int) size());
     }
 
-    /// deletes all defined effects
+    /// Removes an effect: when it returns, the audio core does not use the effect any more and it
+    /// can be deleted. Not on the audio core: it waits for the end of the running block
+    bool removeEffect(AudioEffect *effect){
+        TRACED();
+        return effects.removeEffect(effect);
+    }
+
+    /// removes all defined effects: returns when the audio core does not use them any more;
+    /// they are owned by the caller, which may delete them afterwards
     void clear() {
         TRACED();
         effects.clear();
@@ -377,11 +633,299 @@ class AudioEffectStreamT : public ModifyingStream {
         return effects.findEffect(id);
     }
 
+    /// Provides the time in us which was needed to apply the effects on the last block
+    uint32_t processingTime() {
+        return process_time_us;
+    }
+
+    /// Enters the idle mode after the indicated time of digital silence (0 = never): the effects
+    /// are bypassed. The first block with a sample above the level is processed again with
+    /// reset effect states.
+    void setIdleAfter(uint32_t ms, T level = 0){
+        idle_frames = (uint64_t)ms * info.sample_rate / 1000;
+        idle_level = level;
+        silent_frames = 0;
+        idle = false;
+    }
+
+    /// The effects are bypassed because of silence
+    bool isIdle() {
+        return idle;
+    }
+
+    /// Copies of the blocks before and after the effects (nullptr = none)
+    void setTap(AudioTap *tap){
+        p_tap = tap;
+    }
+
   protected:
     AudioEffectCommon effects;
     bool active = false;
+    uint32_t process_time_us = 0;
+    uint32_t idle_frames = 0;
+    uint32_t silent_frames = 0;
+    T idle_level = 0;
+    std::atomic<bool> idle{false};
     Stream *p_io=nullptr;
     Print *p_print=nullptr;
+    AudioTap *p_tap=nullptr;
+
+    /// counts the silent frames: returns true if the effects can be bypassed
+    bool updateIdle(const T *samples, int frames){
+        int count = frames * info.channels;
+        int j = 0;
+        while (j < count && samples[j] <= idle_level && samples[j] >= -idle_level) j++;
+        if (j < count) {
+            if (idle) {
+                // signal returned: start without the state of the old signal
+                EffectGraph &graph = effects.acquire();
+                for (int k = 0; k < graph.size(); k++) graph[k]->resetState();
+                effects.release();
+                idle = false;
+            }
+            silent_frames = 0;
+            return false;
+        }
+        if (silent_frames < idle_frames) silent_frames += frames;
+        if (silent_frames >= idle_frames) idle = true;
+        return idle;
+    }
+};
+
+/**
+ * @brief Asynchronous sample rate converter for int16_t frames with a cubic Farrow
+ * interpolator. The input is written to a FIFO and read with the ratio (input
+ * frames per output frame). A PI control loop adjusts the ratio, so that the number
+ * of buffered input frames stays at the target: this absorbs the drift between the
+ * input and the output clock with a low and constant latency. The target must be
+ * below the size of the FIFO, the buffered input must include all input frames which
+ * were received but not yet interpolated.
+ * It does not depend on any device, so it can be tested with synthetic clocks.
+ * @ingroup transform
+ * @author W. Voigt
+ * @copyright GPLv3
+*/
+class AsyncResampler {
+  public:
+    /// Allocates the FIFO: fifoFrames must be a power of 2
+    bool begin(int channels, int fifoFrames = 2048, int targetFrames = 512){
+        if (fifoFrames & (fifoFrames - 1)) {
+            LOGE("fifoFrames must be a power of 2: %d", fifoFrames);
+            return false;
+        }
+        this->channels = channels;
+        mask = fifoFrames - 1;
+        fifo.resize(fifoFrames * channels);
+        memset(fifo.data(), 0, fifo.size() * sizeof(int16_t));
+        read_pos = write_pos = 0;
+        position = 0.0f;
+        setTarget(targetFrames);
+        return true;
+    }
+
+    /// Defines the number of buffered input frames which is regulated
+    void setTarget(int frames){
+        target = frames;
+        filtered = frames;
+        integral = 0.0f;
+        current_ratio = 1.0f;
+    }
+
+    int targetFrames() { return target; }
+
+    /// Defines the max deviation of the ratio from 1.0 (e.g. 0.002 = 2000 ppm)
+    void setMaxDeviation(float value){
+        max_deviation = value;
+    }
+
+    /// Input frames per output frame
+    float ratio() { return current_ratio; }
+
+    /// Number of frames in the FIFO
+    int available() { return write_pos - read_pos; }
+
+    /// Free space in the FIFO in frames
+    int availableForWrite() { return mask + 1 - available(); }
+
+    /// Number of input frames which are needed to provide the output frames
+    int inputFramesNeeded(int outFrames){
+        int result = (int)(outFrames * current_ratio + position) + history - available() + 1;
+        return result > 0 ? result : 0;
+    }
+
+    /// Adds interleaved input frames: returns the number of frames which were added
+    int write(const int16_t *data, int frames){
+        if (frames > availableForWrite()) frames = availableForWrite();
+        for (int j = 0; j < frames; j++){
+            int16_t *p_frame = fifo.data() + ((write_pos + j) & mask) * channels;
+            for (int ch = 0; ch < channels; ch++){
+                p_frame[ch] = data[j * channels + ch];
+            }
+        }
+        write_pos += frames;
+        return frames;
+    }
+
+    /// Interpolates interleaved output frames: returns the number of frames
+    int read(int16_t *data, int frames){
+        int result = 0;
+        while (result < frames && available() > history){
+            float t = position;
+            for (int ch = 0; ch < channels; ch++){
+                float xm1 = fifo[((read_pos - 1) & mask) * channels + ch];
+                float x0 = fifo[(read_pos & mask) * channels + ch];
+                float x1 = fifo[((read_pos + 1) & mask) * channels + ch];
+                float x2 = fifo[((read_pos + 2) & mask) * channels + ch];
+                // Farrow structure of the cubic Hermite interpolation
+                float c1 = 0.5f * (x1 - xm1);
+                float c2 = xm1 - 2.5f * x0 + 2.0f * x1 - 0.5f * x2;
+                float c3 = 0.5f * (x2 - xm1) + 1.5f * (x0 - x1);
+                float y = ((c3 * t + c2) * t + c1) * t + x0;
+                if (y > 32767.0f) y = 32767.0f;
+                else if (y < -32768.0f) y = -32768.0f;
+                data[result * channels + ch] = y;
+            }
+            position += current_ratio;
+            int step = (int)position;
+            position -= step;
+            read_pos += step;
+            result++;
+        }
+        return result;
+    }
+
+    /// Control loop: call once per block with the number of buffered input frames
+    /// (FIFO and e.g. the input DMA buffers) and the output frames of the block
+    void update(float bufferedFrames, int outFrames){
+        float coeff = filter_coeff * outFrames;
+        filtered += (coeff < 1.0f ? coeff : 1.0f) * (bufferedFrames - filtered);
+        float error = (filtered - target) / target;
+        integral += ki * outFrames * error;
+        if (integral > max_deviation) integral = max_deviation;
+        else if (integral < -max_deviation) integral = -max_deviation;
+        float ratio = 1.0f + kp * error + integral;
+        if (ratio > 1.0f + max_deviation) ratio = 1.0f + max_deviation;
+        else if (ratio < 1.0f - max_deviation) ratio = 1.0f - max_deviation;
+        current_ratio = ratio;
+    }
+
+    /// Buffered input frames after the low pass of the control loop
+    float bufferedFrames() { return filtered; }
+
+  protected:
+    static const int history = 3;   // frames needed by the interpolation
+    Vector<int16_t> fifo{0};
+    int channels = 2;
+    uint32_t mask = 0;
+    uint32_t read_pos = 0, write_pos = 0;
+    float position = 0.0f;
+    float current_ratio = 1.0f;
+    int target = 512;
+    float filtered = 512.0f;
+    float integral = 0.0f;
+    float max_deviation = 0.002f;
+    // per output frame: low pass of 2 s against the jitter of the measurement, the loop settles
+    // in about 30 s at 44.1 kHz (target 512)
+    float filter_coeff = 1.1e-5f;
+    float kp = 0.002f;
+    float ki = 2.5e-9f;
+};
+
+/**
+ * @brief Stream which reads the input with the AsyncResampler: the output clock
+ * determines how often readBytes() is called and the ratio follows the drift of
+ * the input clock (e.g. the recovered SPDIF clock of an I2S input).
+ * The available() of an I2S input does not report the filling of its DMA buffers, so
+ * each call drains the input into the FIFO: it reads chunks until a read has to wait
+ * for the input clock. The frames which arrived during this wait are subtracted, so the
+ * control loop measures the buffered input at the time of the call (timestamped input).
+ * @ingroup transform
+ * @author W. Voigt
+ * @copyright GPLv3
+*/
+class AsyncResampleStream : public ModifyingStream {
+  public:
+    AsyncResampleStream() = default;
+
+    AsyncResampleStream(Stream &io){
+        setStream(io);
+    }
+
+    /// Starts the resampler: the target latency is given in frames, the input is read in
+    /// chunks of the size of its DMA buffers
+    bool begin(AudioInfo cfg, int targetFrames = 512, int fifoFrames = 2048, int chunkFrames = 128){
+        info = cfg;
+        if (info.bits_per_sample != 16) {
+            LOGE("bits_per_sample not supported: %d", info.bits_per_sample);
+            return false;
+        }
+        if (targetFrames + 2 * chunkFrames > fifoFrames) {
+            LOGE("targetFrames too big for the FIFO: %d", targetFrames);
+            return false;
+        }
+        chunk_frames = chunkFrames;
+        // a read which takes a quarter of the chunk waited for the input
+        wait_us = 250000.0f * chunkFrames / info.sample_rate;
+        is_started = false;
+        input.resize(fifoFrames * info.channels);
+        return resampler.begin(info.channels, fifoFrames, targetFrames);
+    }
+
+    void setStream(Stream &io) override {
+        p_io = &io;
+    }
+
+    void setOutput(Print &print) override {}
+
+    size_t readBytes(uint8_t *data, size_t len) override {
+        if (p_io == nullptr) return 0;
+        int frame_size = info.channels * sizeof(int16_t);
+        int frames = len / frame_size;
+        uint32_t start = micros();
+        // the first output starts with the target in the FIFO
+        int needed = resampler.inputFramesNeeded(frames);
+        if (!is_started) needed += resampler.targetFrames();
+        // the needed frames and everything which was already received
+        while (resampler.availableForWrite() > 0) {
+            int chunk = needed > chunk_frames ? needed : chunk_frames;
+            if (chunk > resampler.availableForWrite()) chunk = resampler.availableForWrite();
+            uint32_t read_start = micros();
+            int read = p_io->readBytes((uint8_t*)input.data(), chunk * frame_size) / frame_size;
+            resampler.write(input.data(), read);
+            needed -= read;
+            if (read == 0 || (needed <= 0 && micros() - read_start >= wait_us)) break;
+        }
+        // buffered input at the start of the call: the input is empty after the wait,
+        // the frames which arrived since the start are subtracted
+        if (is_started) {
+            float arrived = (micros() - start) * 1e-6f * info.sample_rate;
+            resampler.update(resampler.available() - arrived, frames);
+        }
+        is_started = true;
+        return resampler.read((int16_t*)data, frames) * frame_size;
+    }
+
+    size_t write(const uint8_t *data, size_t len) override { return 0; }
+
+    int available() override {
+        return resampler.available() * info.channels * sizeof(int16_t);
+    }
+
+    /// Provides access to the ratio and control loop
+    AsyncResampler &asrc() { return resampler; }
+
+    /// Actual latency of the buffered input in ms
+    float latencyMs() {
+        return 1000.0f * resampler.bufferedFrames() / info.sample_rate;
+    }
+
+  protected:
+    AsyncResampler resampler;
+    Vector<int16_t> input{0};
+    Stream *p_io = nullptr;
+    int chunk_frames = 128;
+    uint32_t wait_us = 725;
+    bool is_started = false;
 };
 
 #if defined(USE_VARIANTS) && __cplusplus >= 201703L || defined(DOXYGEN)
@@ -495,7 +1039,8 @@ class AudioEffectStream : public ModifyingStream {
         std::visit( [effect](auto&& e) {e.addEffect(effect);}, variant );
     }
 
-    /// deletes all defined effects
+    /// removes all defined effects: returns when the audio core does not use them any more;
+    /// they are owned by the caller, which may delete them afterwards
     void clear() {
         std::visit( [](auto&& e) {e.clear();}, variant );
     }
@@ -0,0 +1,156 @@
+// Adaptive threshold: a slow control loop on core 0 instead of adjusting the threshold with the
+// IR remote when the programme changes (news, ads, films).
+// The audio core only accumulates the sums of ProgrammeStatistics (crest factor of the compressor
+// output, gain reduction histogram), the loudness comes from the LoudnessMeter. Every period the
+// loop moves the threshold by at most maxStep % towards the target crest factor (dynamic range)
+// within the bounds. The compressor crossfades to the new settings and the makeup gain ramps
+// over a block, so the steps are glitch-free. Each decision is kept in a log: GET /api/auto (CSV).
+
+#define AUTO_LOG_SIZE 16
+
+struct AutoThresholdConfig {
+  float targetCrestDb = 12.0f;    // peak to RMS of the output
+  float toleranceDb = 1.5f;       // no change within target +- tolerance
+  uint8_t minThreshold = 10;      // bounds in %
+  uint8_t maxThreshold = 60;
+  uint8_t maxStep = 2;            // % per decision
+  float periodSeconds = 5.0f;     // time between two decisions
+  float maxGainReductionDb = 15;  // 90% of the blocks must have less gain reduction
+  float minLufs = -50.0f;         // quieter passages are not evaluated
+  float makeupShare = 0.5f;       // makeup = share * median gain reduction, 0 = makeup is not changed
+  float maxMakeupDb = 6.0f;
+  float makeupStepDb = 1.0f;      // per decision
+};
+
+struct AutoDecision {
+  uint32_t timeMs;
+  float crestDb;
+  float lufs;
+  uint8_t medianGr, p90Gr;        // gain reduction in dB
+  uint8_t oldThreshold, threshold;
+  float makeupDb;
+  const char *reason;
+};
+
+class AutoThreshold {
+  public:
+    void begin(ProgrammeStatistics &statistics, AutoThresholdConfig config = AutoThresholdConfig()) {
+      p_statistics = &statistics;
+      cfg = config;
+      clear();
+    }
+
+    /// control core: collects the intervals and decides once per period; returns true if the
+    /// threshold was changed
+    bool update(uint32_t nowMs, float shortTermLufs, uint8_t &threshold) {
+      ProgrammeInterval interval;
+      while (p_statistics != nullptr && p_statistics->pop(interval)) {
+        frames += interval.frames;
+        sum_squares += interval.mean_square * interval.frames;
+        if (interval.peak > peak) peak = interval.peak;
+        for (int j = 0; j < ProgrammeInterval::bins; j++) histogram[j] += interval.gain_reduction[j];
+      }
+      if (frames == 0 || nowMs - period_start < cfg.periodSeconds * 1000) return false;
+
+      AutoDecision decision;
+      decision.timeMs = nowMs;
+      decision.lufs = shortTermLufs;
+      float mean_square = sum_squares / frames;
+      decision.crestDb = peak > 0.0f && mean_square > 0.0f ? 20.0f * log10f(peak) - 10.0f * log10f(mean_square) : 0.0f;
+      decision.medianGr = percentile(0.5f);
+      decision.p90Gr = percentile(0.9f);
+      decision.oldThreshold = threshold;
+      int value = threshold;
+      if (shortTermLufs < cfg.minLufs) {
+        decision.reason = "quiet";
+      } else if (decision.p90Gr >= cfg.maxGainReductionDb) {
+        decision.reason = "overcompressed";
+        value += cfg.maxStep;
+      } else if (decision.crestDb > cfg.targetCrestDb + cfg.toleranceDb) {
+        // no lower threshold close to the limit of the gain reduction: it would oscillate
+        bool room = decision.p90Gr + guard_db < cfg.maxGainReductionDb;
+        decision.reason = room ? "dynamic" : "limit";
+        if (room) value -= cfg.maxStep;
+      } else if (decision.crestDb < cfg.targetCrestDb - cfg.toleranceDb) {
+        decision.reason = "flat";
+        value += cfg.maxStep;
+      } else {
+        decision.reason = "hold";
+      }
+      if (value < cfg.minThreshold) value = cfg.minThreshold;
+      else if (value > cfg.maxThreshold) value = cfg.maxThreshold;
+      decision.threshold = value;
+      // makeup follows the typical gain reduction
+      if (cfg.makeupShare > 0.0f && shortTermLufs >= cfg.minLufs) {
+        float target = cfg.makeupShare * decision.medianGr;
+        if (target > cfg.maxMakeupDb) target = cfg.maxMakeupDb;
+        float delta = target - makeup_db;
+        if (delta > cfg.makeupStepDb) delta = cfg.makeupStepDb;
+        else if (delta < -cfg.makeupStepDb) delta = -cfg.makeupStepDb;
+        makeup_db += delta;
+      }
+      decision.makeupDb = makeup_db;
+      log[log_count++ % AUTO_LOG_SIZE] = decision;
+      clear();
+      period_start = nowMs;
+      bool result = value != threshold;
+      threshold = value;
+      return result;
+    }
+
+    /// bounds of the threshold in %: used from the next decision (control core)
+    void setBounds(uint8_t minThreshold, uint8_t maxThreshold) {
+      cfg.minThreshold = minThreshold;
+      cfg.maxThreshold = maxThreshold < minThreshold ? minThreshold : maxThreshold;
+    }
+
+    /// makeup gain in dB (only changed with makeupShare > 0)
+    float makeupDb() { return makeup_db; }
+
+    /// the last decision
+    const AutoDecision &last() { return log[(log_count + AUTO_LOG_SIZE - 1) % AUTO_LOG_SIZE]; }
+
+    /// the decisions as CSV, the oldest first: returns the length
+    int toCsv(char *text, int size) {
+      int len = snprintf(text, size, "time_s,crest_db,lufs,median_gr_db,p90_gr_db,old_threshold,threshold,makeup_db,reason\n");
+      uint32_t first = log_count > AUTO_LOG_SIZE ? log_count - AUTO_LOG_SIZE : 0;
+      for (uint32_t j = first; j < log_count && len < size; j++) {
+        const AutoDecision &d = log[j % AUTO_LOG_SIZE];
+        len += snprintf(text + len, size - len, "%lu,%.1f,%.1f,%u,%u,%u,%u,%.1f,%s\n", (unsigned long)(d.timeMs / 1000),
+                        d.crestDb, d.lufs, d.medianGr, d.p90Gr, d.oldThreshold, d.threshold, d.makeupDb, d.reason);
+      }
+      return len < size ? len : size - 1;
+    }
+
+  protected:
+    const float guard_db = 3.0f;
+    ProgrammeStatistics *p_statistics = nullptr;
+    AutoThresholdConfig cfg;
+    uint32_t period_start = 0;
+    uint32_t frames = 0;
+    double sum_squares = 0.0;
+    float peak = 0.0f;
+    uint32_t histogram[ProgrammeInterval::bins];
+    float makeup_db = 0.0f;
+    AutoDecision log[AUTO_LOG_SIZE];
+    uint32_t log_count = 0;
+
+    void clear() {
+      frames = 0;
+      sum_squares = 0.0;
+      peak = 0.0f;
+      memset(histogram, 0, sizeof(histogram));
+    }
+
+    /// gain reduction in dB which is not exceeded by the share of the blocks
+    uint8_t percentile(float share) {
+      uint32_t total = 0;
+      for (int j = 0; j < ProgrammeInterval::bins; j++) total += histogram[j];
+      uint32_t sum = 0;
+      for (int j = 0; j < ProgrammeInterval::bins; j++) {
+        sum += histogram[j];
+        if (sum > 0 && sum >= share * total) return j;
+      }
+      return 0;
+    }
+};
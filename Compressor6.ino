@@ -13,10 +13,10 @@
 // Board: ESP32 Wrover Kit (also for HiFi-ESP32 Board)
 // Partition Scheme: Minimal SPIFFS with OTA
 
-// For Stereo Compressor using modified versions of AudioEffects.h and AudioEffect.h
-// Copy the modified files into the Arduino library folder: Arduino\libraries\audio-tools\src\AudioTools\CoreAudio\AudioEffects\
-// If you are using the original Audio Tools library, you have to comment out the lines with 'Compressor_Stereo' and 'Compressor_Active'.
-// in this case, the compressor is working in mono mode.
+// Requires the modified versions of AudioEffects.h, AudioEffect.h and FastMath.h
+// Copy the modified files into the Arduino library folder: Arduino\libraries\audio-tools\src\AudioTools\CoreAudio\AudioEffects
+// The original files of the Audio Tools library do not work any more: the sketch uses the block processing,
+// the idle bypass, the TruePeakDetector, the LoudnessMeter, the ASRC etc. of the modified files.
 
 // # Test Output to SPDIF:
 // If you encounter some quality issues you can increase the DEFAULT_BUFFER_SIZE (e.g. to 2048) 
@@ -30,18 +30,43 @@
 #define LED_RED 21 // pull down, must be low at boot
 // #define TEST_GENERATOR
 #define TOS_LINK
+#define TRUE_PEAK false // true = compressor and limiter of DYNAMICS detect 4x oversampled true-peaks (costs CPU)
+#define AUTO_MAKEUP false // true = makeup gain slowly levels the loudness to targetLufs
+#define AUTO_THRESHOLD false // true = slow loop steers the threshold (and without AUTO_MAKEUP the makeup) to TARGET_CREST
+#define TARGET_CREST 12 // dB peak to RMS of the output for AUTO_THRESHOLD
+#define AUTO_THRESHOLD_MIN 10 // default bounds of AUTO_THRESHOLD in %, can be changed in the web interface
+#define AUTO_THRESHOLD_MAX 60
+#define STEREO_LINK Compressor::LinkMax // detector: LinkMax, LinkAverage, LinkRms or LinkMidSide
+#define SIDECHAIN false // true = the PCM1802 ADC is the key input of the compressor (ducking), needs the DAC output
+#define DYNAMICS false // true = DynamicsProcessor (expander, compressor, limiter) instead of the Compressor, no presets
+#define EQ false // true = parametric EQ for dialogue: low cut and presence boost
+#define EQ_BEFORE_COMPRESSOR true // false = EQ after the compressor
+#define ASRC true // true = asynchronous sample rate converter absorbs the clock drift of SPDIF in and out
+#define LOW_LATENCY true // true = output buffers are reduced until underruns occur (lip-sync)
+#define OUT_BUFFER_SIZE 512 // bytes per output buffer
+#define IDLE_AFTER 60 // seconds of digital silence (TV off) until the effects are bypassed with a low CPU clock, 0 = never
+#define HISTORY_SECONDS 300 // gain reduction history in PSRAM (only 10 s without PSRAM)
+#define SPECTRUM 512 // FFT size of the spectrum analyser in the web UI: 256, 512 or 1024, 0 = off
+#define SPECTRUM_EVERY 8 // the audio core copies the frames of one FFT every n blocks
+// #define BENCHMARK // prints the processing time per block
 
 #include "HttpServer.h"   // https://github.com/pschatzmann/TinyHttp
 #include "AudioTools.h"   // https://github.com/pschatzmann/arduino-audio-tools.git
 #include "AudioTools/AudioLibs/SPDIFOutput.h" // Arduino\libraries\audio-tools\src\AudioTools\CoreAudio\AudioEffects
 #include <Preferences.h>
 Preferences preferences;
+#include <Persistence.h>
+#include <Presets.h>
 #include <IR_Remote.h>
+#include <WebUi.h>
+#include <LatencyController.h>
+#include <History.h>
+#include <Spectrum.h>
+#include <AutoThreshold.h>
 
 // Server
 WiFiServer wifi;
 HttpServer server(wifi);
-HttpParameters parameters;
 const char *ssid = "YOUR_SSID";
 const char *password = "YOUR_PWD";
 TaskHandle_t TaskCore0; // Handle für den Task
@@ -52,14 +77,34 @@ const uint16_t channels = 2;
 const uint8_t bits_per_sample = 16;
 AudioInfo info(sample_rate, channels, bits_per_sample);
 
+// Settings are written deferred to NVS, writes stall both cores
+PreferencesBackend storage(preferences, "Compressor");
+PersistenceManager persistence(storage, "settings", &presetBlob, sizeof(PresetBlob));
+
 // Effects control input initial
 uint8_t ratio = 100;             // Ratio
 uint8_t threshold = 30;       // Threshold in %
+uint8_t mix = 100;            // compressed part in %, the rest is the dry signal (parallel compression)
 uint16_t attackTime = 10;     // Attack-Zeit in ms
 uint16_t releaseTime = 500;   // Release-Zeit in ms
+int8_t targetLufs = -23;      // Ziel-Lautheit für AUTO_MAKEUP in LUFS
+uint8_t autoMin = AUTO_THRESHOLD_MIN; // bounds of AUTO_THRESHOLD in %
+uint8_t autoMax = AUTO_THRESHOLD_MAX;
+std::atomic<uint32_t> paramVersion{1}; // changed by web and IR (both on core 0): for the long poll
+// IR commands received on core 1, applied by controlWork() on core 0: the settings of the
+// effects and the presets have one writer
+std::atomic<int> irDelta{0};     // pending change of the threshold in %
+std::atomic<int> irPreset{-1};   // pending preset slot, -1 = none
+uint32_t applyLatency = 0;    // duration of the last parameter change in us
 
 // Effects
+TruePeakDetector truePeak(TRUE_PEAK); // only calculated when active
 Compressor compressor ((float)sample_rate, (float)attackTime, (float)releaseTime, 0, (float)threshold, (float)ratio);
+DynamicsProcessor dynamics((float)sample_rate); // one envelope for expander, compressor and limiter
+ParametricEQ eq((float)sample_rate);
+LoudnessMeter loudness((float)sample_rate); // EBU R128 of the compressor output
+MakeupGain makeup;
+ProgrammeStatistics statistics((float)sample_rate); // sums for AUTO_THRESHOLD
 
 #ifdef TEST_GENERATOR
   // Test with Sine Generator
@@ -69,123 +114,342 @@ Compressor compressor ((float)sample_rate, (float)attackTime, (float)releaseTime
 #else
   // Streams
   I2SStream in;     // Toslink in
-  AudioEffectStream effects(in);   // input
+  #if ASRC
+    AsyncResampleStream asrc(in);  // input clock -> output clock
+    AudioEffectStream effects(asrc);   // input
+  #else
+    AudioEffectStream effects(in);   // input
+  #endif
 #endif
 
 #ifdef TOS_LINK
+  #if SIDECHAIN
+    #error "SIDECHAIN: the PCM1802 shares the clocks of the DAC port, comment out TOS_LINK"
+  #endif
   SPDIFOutput out;  // Toslink out
 #else
   I2SStream out;  // DAC
 #endif
 
-StreamCopy copier(out, effects); // copies effects into i2s
-
-static const char PROGMEM htmlForm[] = R"rawliteral(
-<!DOCTYPE html>
-<html>
-<head>
-<meta name="viewport" content="width=device-width, initial-scale=1">
-<title>Compressor</title>
-<style>
-body {background-color: #cccccc; font-family: Arial; text-align: left; margin: 0px auto; padding-top: 20px; padding-left: 30px;}
-.slider {width: 95%;}
-</style>
-</head>
-<body>
-<h2>Compressor</h2>
-<form method='post'>
-<div>
-Ratio 1 - 200 &nbsp;&nbsp;<b>%ratio%</b><br>
-<input type='range' class='slider' name='ratio' onchange='this.form.submit()' min='1' max='201' step='10' value='%ratio%'>
-</div><div>
-<br>Threshold 5 - 100 &nbsp;&nbsp;<b>%thresh%</b><br>
-<input type='range' class='slider' name='thresh' onchange='this.form.submit()' min='5' max='100' step='1' value='%thresh%'>
-</div><div>
-<br>Attack 5 - 100ms &nbsp;&nbsp;<b>%attack%</b><br>
-<input type='range' class='slider' name='attack' onchange='this.form.submit()' min='5' max='100' step='5' value='%attack%'>
-</div><div>
-<br>Release 10 - 1000ms &nbsp;&nbsp;<b>%release%</b><br>
-<input type='range' class='slider' name='release' onchange='this.form.submit()' min='10' max='1010' step='20' value='%release%'>
-</div>
-</form>
-</body>
-</html>
-)rawliteral";
-
-
-// Update values in effects
+PacedOutput paced(out);     // limits the filling of the output buffers
+StreamCopy copier(paced, effects); // copies effects into i2s
+LatencyController latency;  // depth of the output buffers
+const int outBufferCount = 8;
+int inputDmaFrames = 0;     // capacity of the input DMA buffers (config_in) in frames
+const bool latencyEstimated = !ASRC; // without the ASRC the filling of the input is unknown
+HistoryRecorder history;    // gain reduction of the last minutes
+AudioTap tap;               // blocks before and after the effects for the spectrum
+SpectrumAnalyzer spectrum(tap);
+AutoThreshold autoThreshold; // decisions: GET /api/auto
+
+// Update values in effects: the compressor gets all of them in one block
 void updateValues(){
-  compressor.setCompressionRatio((float)ratio);
-  compressor.setThreshold((float)threshold);
-  compressor.setAttack((float)attackTime);
-  compressor.setRelease((float)releaseTime);
+  CompressorSettings settings = Compressor::calculateSettings((float)sample_rate, attackTime, releaseTime, threshold, ratio, mix);
+  compressor.setSettings(settings);
+  // same parameters for the DynamicsProcessor
+  dynamics.setCompressorThreshold(settings.threshold);
+  dynamics.setCompressorRatio(settings.ratio);
+  dynamics.setAttack((float)attackTime);
+  dynamics.setRelease((float)releaseTime);
  }
 
 void printValues() {
     char msg[120];
-    snprintf(msg, 120, "==> updated values %d %d %d %d",ratio, threshold, attackTime, releaseTime);
+    snprintf(msg, 120, "==> updated values %d %d %d %d %d",ratio, threshold, mix, attackTime, releaseTime);
     Serial.println(msg);        
 }
 
-void getHtml(HttpServer *server, const char*requestPath, HttpRequestHandlerLine *hl) { 
-    // provide html and replace variables with actual values
-    tinyhttp::Str html(2000);
-    html.set(htmlForm);
-    html.replace("%ratio%",ratio); html.replace("%ratio%",ratio);
-    html.replace("%thresh%",threshold); html.replace("%thresh%",threshold);
-    html.replace("%attack%",attackTime); html.replace("%attack%",attackTime);
-    html.replace("%release%",releaseTime); html.replace("%release%",releaseTime);
-    server->reply("text/html", html.c_str(), 200);
-};
+bool selectPreset(int slot) {
+    if (!Preset_select(slot, compressor)) return false; // only a pointer swap
+    Preset &p = presetBlob.presets[slot];
+    ratio = p.ratio;
+    threshold = p.threshold;
+    mix = p.mix;
+    attackTime = p.attackTime;
+    releaseTime = p.releaseTime;
+    Serial.print("Preset: ");
+    Serial.println(p.name);
+    return true;
+}
 
-void postData(HttpServer *server, const char*requestPath, HttpRequestHandlerLine *hl) { 
-    // parse the parameters
-    parameters.parse(server->client()); // timeout verkleinert in HttpParameters.h
-    // update parameters
-    ratio = parameters.getInt("ratio");
-    threshold = parameters.getInt("thresh");
-    attackTime = parameters.getInt("attack");
-    releaseTime = parameters.getInt("release");
-    // return updated html       
-    // getHtml(server, requestPath, hl); 
-    //server->reply("text/html", "", 302);
-    //server->client().print("Location: /\r\n\r\n");
-    server->client().println("HTTP/1.1 302 Found");
-    server->client().println("Location: /"); // reload command
-    server->client().println("Content-Length: 0");
-    server->client().println("Connection: close");
-    server->client().println("\r\n");
-    updateValues();
-    preferences.begin("Compressor", false);
-    preferences.putUChar("ratio", ratio);
-    preferences.putUChar("threshold", threshold);
-    preferences.putUShort("attackTime", attackTime);
-    preferences.putUShort("releaseTime", releaseTime);
-    preferences.end();
-    // printValues();
+// the values of the web interface are stored in the blob
+void storeActual() {
+    presetBlob.actual = {"actual", ratio, threshold, mix, attackTime, releaseTime};
+    presetBlob.autoMin = autoMin;
+    presetBlob.autoMax = autoMax;
+}
+
+// sends a complete response: we write it directly to provide our own headers
+void sendHeader(HttpServer *server, int code, const char *type, size_t len, const char *headers = "") {
+    char header[256];
+    const char *status = code == 200 ? "OK" : code == 304 ? "Not Modified" : "Bad Request";
+    snprintf(header, 256, "HTTP/1.1 %d %s\r\nContent-Type: %s\r\nContent-Length: %u\r\n%sConnection: close\r\n\r\n",
+             code, status, type, (unsigned)len, headers);
+    server->client().print(header);
+}
+
+void sendReply(HttpServer *server, int code, const char *type, const uint8_t *data, size_t len, const char *headers = "") {
+    sendHeader(server, code, type, len, headers);
+    if (len > 0) server->client().write(data, len);
+}
+
+// finds "key":value in a small json object
+bool jsonInt(const char *json, const char *key, int &value) {
+    char pattern[24];
+    snprintf(pattern, 24, "\"%s\"", key);
+    const char *pos = strstr(json, pattern);
+    if (pos == nullptr) return false;
+    pos = strchr(pos + strlen(pattern), ':');
+    if (pos == nullptr) return false;
+    value = atoi(pos + 1);
+    return true;
+}
+
+bool isEtag(HttpServer *server, const char *etag) {
+    const char *value = server->requestHeader().get("If-None-Match");
+    return value != nullptr && strcmp(value, etag) == 0;
+}
+
+// the static web interface: gzipped in flash, cached by the browser
+void getUi(HttpServer *server, const char*requestPath, HttpRequestHandlerLine *hl) { 
+    if (isEtag(server, WEB_UI_ETAG)) {
+        sendReply(server, 304, "text/html", nullptr, 0, "ETag: " WEB_UI_ETAG "\r\n");
+        return;
+    }
+    sendReply(server, 200, "text/html", webUi, webUiSize,
+              "Content-Encoding: gzip\r\nCache-Control: max-age=86400\r\nETag: " WEB_UI_ETAG "\r\n");
 };
 
+void sendParams(HttpServer *server) {
+    char json[256], headers[48]; // ETag of up to 10 digits
+    uint32_t version = paramVersion.load();
+    int len = snprintf(json, 256, "{\"version\":%lu,\"ratio\":%d,\"thresh\":%d,\"mix\":%d,\"attack\":%d,\"release\":%d,\"autoMin\":%d,\"autoMax\":%d,\"preset\":%d,\"presets\":[",
+                       (unsigned long)version, ratio, threshold, mix, attackTime, releaseTime, autoMin, autoMax, presetBlob.selected);
+    for (int j = 0; j < PRESET_COUNT && len < 200; j++) {
+        len += snprintf(json + len, 256 - len, "%s\"%s\"", j > 0 ? "," : "", presetBlob.presets[j].name);
+    }
+    len += snprintf(json + len, 256 - len, "]}");
+    snprintf(headers, sizeof(headers), "ETag: \"%lu\"\r\nCache-Control: no-store\r\n", (unsigned long)version);
+    sendReply(server, 200, "application/json", (const uint8_t*)json, len, headers);
+}
+
+// adaptive threshold on core 0: the same path as a change by the web interface
+void updateAutoThreshold() {
+    uint8_t value = threshold;
+    if (autoThreshold.update(millis(), loudness.shortTerm(), value)) {
+        const AutoDecision &d = autoThreshold.last();
+        char msg[140];
+        snprintf(msg, 140, "==> auto threshold %u -> %u (%s): crest %.1f dB, %.1f LUFS, gain reduction %u / %u dB, makeup %.1f dB",
+                 d.oldThreshold, d.threshold, d.reason, d.crestDb, d.lufs, d.medianGr, d.p90Gr, d.makeupDb);
+        Serial.println(msg);
+        threshold = value;
+        updateValues(); // nur temporär, wird nicht gespeichert
+        paramVersion++;
+    }
+    if (!AUTO_MAKEUP) makeup.setGainDb(autoThreshold.makeupDb());
+}
+
+// IR commands on core 0, see controlWork()
 void IR_SetThreshold(int tdelta) {
     int thresh = threshold;
     thresh += tdelta;
     if (thresh < 1.0) thresh = 1.0;
     else if (thresh > 100.0) thresh = 100.0;
     threshold = (uint8_t)thresh;
-    compressor.setThreshold((float)threshold); // nur temporär, wird nicht gespeichert
+    updateValues(); // nur temporär, wird nicht gespeichert
+    paramVersion++;
+}
+
+void IR_SelectPreset(int slot) {
+    if (selectPreset(slot)) paramVersion++; // nur temporär, wird nicht gespeichert
+}
+
+// the work of core 0 besides the requests: also called while a long poll waits
+void controlWork() {
+    int slot = irPreset.exchange(-1);
+    if (slot >= 0) IR_SelectPreset(slot);
+    int delta = irDelta.exchange(0);
+    if (delta != 0) IR_SetThreshold(delta);
+    int blocks = loudness.update(); // gating of the loudness on core 0
+    spectrum.update(); // FFT of the copied blocks
+    if (AUTO_THRESHOLD) updateAutoThreshold();
+    if (AUTO_MAKEUP && blocks > 0) makeup.updateAuto(loudness.shortTerm(), 0.1 * blocks);
+    // write changed settings preferably during silence
+    if (persistence.update(millis(), effects.isIdle() || loudness.momentary() < -60)) {
+      char msg[60];
+      snprintf(msg, 60, "==> settings saved in %lu us", (unsigned long)persistence.lastCommitTime());
+      Serial.println(msg);
+    }
+}
+
+// GET all parameters: with If-None-Match this is a long poll which answers when the values change
+void getParams(HttpServer *server, const char*requestPath, HttpRequestHandlerLine *hl) { 
+    const char *etag = server->requestHeader().get("If-None-Match");
+    if (etag != nullptr) {
+        uint32_t version = strtoul(etag[0] == '"' ? etag + 1 : etag, nullptr, 10);
+        uint32_t start = millis();
+        // we have only one connection: stop waiting when another request arrives.
+        // Meanwhile the other work of core 0 goes on (loudness, spectrum, settings)
+        while (version == paramVersion.load() && millis() - start < 1000 && !wifi.hasClient()) {
+            controlWork();
+            delay(5);
+        }
+        if (version == paramVersion.load()) {
+            sendReply(server, 304, "application/json", nullptr, 0);
+            return;
+        }
+    }
+    sendParams(server);
+};
+
+// PUT parameters as json e.g. {"thresh":40}, {"autoMin":20}, {"preset":1} or {"save":1}
+void putParams(HttpServer *server, const char*requestPath, HttpRequestHandlerLine *hl) { 
+    uint32_t start = micros();
+    char body[128];
+    const char *content_length = server->requestHeader().get("Content-Length");
+    size_t len = content_length != nullptr ? atoi(content_length) : 0;
+    if (len == 0 || len >= sizeof(body)) {
+        sendReply(server, 400, "application/json", nullptr, 0);
+        return;
+    }
+    len = server->client().readBytes(body, len);
+    body[len] = 0;
+
+    int value;
+    bool changed = false;
+    if (jsonInt(body, "ratio", value)) { ratio = constrain(value, 1, 255); changed = true; }
+    if (jsonInt(body, "thresh", value)) { threshold = constrain(value, 1, 100); changed = true; }
+    if (jsonInt(body, "mix", value)) { mix = constrain(value, 0, 100); changed = true; }
+    if (jsonInt(body, "attack", value)) { attackTime = constrain(value, 1, 1000); changed = true; }
+    if (jsonInt(body, "release", value)) { releaseTime = constrain(value, 1, 5000); changed = true; }
+    if (changed) {
+        updateValues();
+        presetBlob.selected = -1;
+    }
+    if (jsonInt(body, "preset", value) && selectPreset(value)) changed = true;
+    if (changed) {
+        storeActual();
+        persistence.markDirty(millis()); // written later as one blob
+        paramVersion++;
+        applyLatency = micros() - start;
+    }
+    // bounds of AUTO_THRESHOLD: not part of the presets, used from the next decision
+    bool bounds = false;
+    if (jsonInt(body, "autoMin", value)) { autoMin = constrain(value, 1, 100); bounds = true; }
+    if (jsonInt(body, "autoMax", value)) { autoMax = constrain(value, autoMin, 100); bounds = true; }
+    if (bounds) {
+        if (autoMin > autoMax) autoMax = autoMin;
+        autoThreshold.setBounds(autoMin, autoMax);
+        storeActual();
+        persistence.markDirty(millis());
+        paramVersion++;
+    }
+    if (jsonInt(body, "store", value) && Preset_store(value, (float)sample_rate, compressor)) {
+        persistence.markDirty(millis());
+        paramVersion++;
+    }
+    if (jsonInt(body, "save", value)) persistence.save();
+    sendParams(server);
+};
+
+// GET the actual measurements
+void getMeters(HttpServer *server, const char*requestPath, HttpRequestHandlerLine *hl) { 
+    char json[200];
+    int len = snprintf(json, 200, "{\"momentary\":%.1f,\"shortTerm\":%.1f,\"integrated\":%.1f,\"truePeak\":%.1f,\"makeup\":%.1f,\"apply\":%lu}",
+                       loudness.momentary(), loudness.shortTerm(), loudness.integrated(), truePeak.maxTruePeakDb(), 
+                       makeup.gainDb(), (unsigned long)applyLatency);
+    sendReply(server, 200, "application/json", (const uint8_t*)json, len, "Cache-Control: no-store\r\n");
+};
+
+// GET the gain reduction history as binary data: decode with tools/decode_history.py
+void getHistory(HttpServer *server, const char*requestPath, HttpRequestHandlerLine *hl) { 
+    HistoryHeader header = history.header();
+    sendHeader(server, 200, "application/octet-stream", sizeof(header) + header.count * sizeof(HistoryRecord),
+               "Cache-Control: no-store\r\n");
+    server->client().write((const uint8_t*)&header, sizeof(header));
+    history.write(server->client(), header);
+};
+
+// GET the spectra before and after the effects as binary frame (see Spectrum.h)
+void getSpectrum(HttpServer *server, const char*requestPath, HttpRequestHandlerLine *hl) { 
+    sendHeader(server, 200, "application/octet-stream", spectrum.size(), "Cache-Control: no-store\r\n");
+    spectrum.write(server->client());
+};
+
+// GET the decisions of AUTO_THRESHOLD as CSV
+void getAuto(HttpServer *server, const char*requestPath, HttpRequestHandlerLine *hl) { 
+    char csv[1600];
+    int len = autoThreshold.toCsv(csv, sizeof(csv));
+    sendReply(server, 200, "text/csv", (const uint8_t*)csv, len, "Cache-Control: no-store\r\n");
+};
+
+// delay from input to output in ms: the output queue is calculated from the timestamps of the
+// writes, the buffered input is measured by the ASRC. Without the ASRC it is an estimate
+// (latencyEstimated): the filling of the input DMA drifts between empty and full and
+// available() does not report it, so half of its capacity is used
+float latencyMs() {
+#if ASRC && !defined(TEST_GENERATOR)
+  float input_frames = asrc.asrc().bufferedFrames();
+#elif !defined(TEST_GENERATOR)
+  float input_frames = 0.5f * inputDmaFrames;
+#else
+  float input_frames = 0;
+#endif
+  return latency.latencyMs(input_frames, paced.queuedFrames(), effects.processingTime());
 }
 
+// GET the latency: the lip-sync offset of the AV receiver can be set to match
+void getLatency(HttpServer *server, const char*requestPath, HttpRequestHandlerLine *hl) { 
+    char json[200];
+    int len = snprintf(json, 200, "{\"active\":%d,\"bufferCount\":%d,\"bufferFrames\":%d,\"latencyMs\":%.1f,\"estimated\":%d,\"marginUs\":%ld,\"minMarginUs\":%ld,\"underruns\":%lu}",
+                       latency.active(), latency.bufferCount(), latency.bufferFrames(), latencyMs(), latencyEstimated,
+                       (long)latency.margin(), (long)latency.minMargin(), (unsigned long)latency.underrunCount());
+    sendReply(server, 200, "application/json", (const uint8_t*)json, len, "Cache-Control: no-store\r\n");
+};
+
 // Function to run on Core 0
 void httpTaskCode( void * parameter ){
   Serial.print("HTTP-Task running on Core: ");
   Serial.println(xPortGetCoreID());
   for(;;){
     server.copy(); 
-    delay(5); // time for processing WiFi
+    controlWork();
+    delay(effects.isIdle() ? 100 : 5); // time for processing WiFi, slower polling in idle mode
   } 
 };
 
 
 
+// starts the output with the indicated number of buffers
+void beginOutput(int bufferCount) {
+#ifdef TOS_LINK
+  // start SPDIF out for TosLink
+  auto config_out = out.defaultConfig();
+  config_out.pin_data = 23; // (MOSI)
+  config_out.port_no = 0;
+  config_out.buffer_size = OUT_BUFFER_SIZE; // 384
+  config_out.buffer_count = bufferCount;
+  out.begin(config_out);
+  Serial.println("SPDIF started");
+#else
+  // start I2S out for DA converter
+  // with SIDECHAIN the PCM1802 (slave) is read in duplex with the same clocks as the DAC
+  auto config_out = out.defaultConfig(SIDECHAIN ? RXTX_MODE : TX_MODE);
+  config_out.copyFrom(info); 
+  config_out.i2s_format = I2S_STD_FORMAT;
+  config_out.is_master = true;
+  config_out.port_no = 0;
+  config_out.pin_data = 22;
+  config_out.pin_bck = 26;  // clk
+  config_out.pin_ws = 25;   // lck
+  config_out.pin_data_rx = 27; // PCM1802 DOUT
+  config_out.buffer_size = OUT_BUFFER_SIZE;
+  config_out.buffer_count = bufferCount;
+  out.begin(config_out);
+  Serial.println("D/A started");
+#endif
+}
+
 // Arduino Setup
 void setup(void) {
   
@@ -193,15 +457,30 @@ void setup(void) {
   pinMode(LED_RED, OUTPUT);
   digitalWrite(LED_GRN, LOW);
   digitalWrite(LED_RED, LOW);
-  Compressor_Stereo  = true; // comment out if using original AudioEffects.h
+  Compressor_Stereo  = true; // false = mono fold-down of the original compressor
   
   // Get Preferences
-  preferences.begin("Compressor", false);
-  ratio = preferences.getUChar("ratio", ratio);
-  threshold = preferences.getUChar("threshold", threshold);
-  attackTime = preferences.getUShort("attackTime", attackTime);
-  releaseTime = preferences.getUShort("releaseTime", releaseTime);
-  preferences.end();
+  // blobs of older builds may contain no actual values (empty name)
+  if (Preset_load(storage, (float)sample_rate) && presetBlob.actual.name[0] != 0) {
+    ratio = presetBlob.actual.ratio;
+    threshold = presetBlob.actual.threshold;
+    mix = presetBlob.actual.mix;
+    attackTime = presetBlob.actual.attackTime;
+    releaseTime = presetBlob.actual.releaseTime;
+    if (presetBlob.autoMin > 0 && presetBlob.autoMin <= presetBlob.autoMax && presetBlob.autoMax <= 100) {
+      autoMin = presetBlob.autoMin;
+      autoMax = presetBlob.autoMax;
+    }
+  } else {
+    // values of older versions
+    preferences.begin("Compressor", false);
+    ratio = preferences.getUChar("ratio", ratio);
+    threshold = preferences.getUChar("threshold", threshold);
+    attackTime = preferences.getUShort("attackTime", attackTime);
+    releaseTime = preferences.getUShort("releaseTime", releaseTime);
+    preferences.end();
+  }
+  storeActual(); // a blob without actual values would restore zeros
 
   Serial.begin(115200);
   // change to Warning to improve the quality
@@ -211,24 +490,19 @@ void setup(void) {
 
   // Setup Server
   HttpLogger.begin(Serial, Error);
-  server.on("/",T_GET, getHtml);
-  server.on("/",T_POST, postData);
+  server.on("/",T_GET, getUi);
+  server.on("/api/params",T_GET, getParams);
+  server.on("/api/params",T_PUT, putParams);
+  server.on("/api/meters",T_GET, getMeters);
+  server.on("/api/latency",T_GET, getLatency);
+  server.on("/api/history",T_GET, getHistory);
+  server.on("/api/spectrum",T_GET, getSpectrum);
+  server.on("/api/auto",T_GET, getAuto);
   server.begin(80, ssid, password);
   server.setTimeout(200); // default = 1000
 
   IR_begin();
 
-  // Den Task im Setup erstellen und an Core 0 "pinnen"
-  xTaskCreatePinnedToCore(
-      httpTaskCode,    /* Name der Funktion (Task) */
-      "HttpCore0",     /* Task-Name */
-      8192,            /* Stack-Größe (RAM) – 8K ist ein sicherer Wert */
-      NULL,            /* Parameter */
-      2,               /* Priorität (etwas höher als Standard-1) */
-      &TaskCore0,      /* Task Handle */
-      0);              /* <-- Core ID 0 */
- 
-
 #ifdef TEST_GENERATOR
   // Generator
   sineWave.begin(info, 500);
@@ -245,47 +519,113 @@ void setup(void) {
   config_in.pin_bck = 18;   // (CLK)  // 14
   config_in.pin_ws = 14;    // (RST)  // 15
   config_in.buffer_size = 512; // minimize lag 256
-  config_in.buffer_count = 2;
+  config_in.buffer_count = ASRC ? 8 : 2; // the ASRC drains the DMA buffers: more of them only add margin
   in.begin(config_in);
+  inputDmaFrames = config_in.buffer_size * config_in.buffer_count / (channels * 2);
   Serial.println("I2S started");
+  #if ASRC
+    asrc.begin(info, 512); // regulated latency of the input in frames
+    Serial.println("ASRC started");
+  #endif
 #endif
 
-#ifdef TOS_LINK
-  // start SPDIF out for TosLink
-  auto config_out = out.defaultConfig();
-  config_out.pin_data = 23; // (MOSI)
-  config_out.port_no = 0;
-  config_out.buffer_size = 512; // 384
-  config_out.buffer_count = 8;
-  out.begin(config_out);
-  Serial.println("SPDIF started");
-#else
-  // start I2S out for DA converter
-  auto config_out = out.defaultConfig(TX_MODE);
-  config_out.copyFrom(info); 
-  config_out.i2s_format = I2S_STD_FORMAT;
-  config_out.is_master = true;
-  config_out.port_no = 0;
-  config_out.pin_data = 22;
-  config_out.pin_bck = 26;  // clk
-  config_out.pin_ws = 25;   // lck
-  out.begin(config_out);
-  Serial.println("D/A started");
-#endif
+  beginOutput(outBufferCount);
+  paced.begin(sample_rate, channels * 2, outBufferCount * OUT_BUFFER_SIZE / (channels * 2));
+  latency.begin((float)sample_rate, OUT_BUFFER_SIZE / (channels * 2), 3, outBufferCount, outBufferCount);
+  latency.setActive(LOW_LATENCY);
+  history.begin(sample_rate, HISTORY_SECONDS, copier.bufferSize() / (channels * 2));
 
   // setup effects
+  eq.setBand(0, ParametricEQ::HighPass, 80);        // low cut
+  eq.setBand(1, ParametricEQ::Peak, 2500, 3, 1.0);  // presence +3 dB
+  eq.setActive(EQ);
+  if (EQ_BEFORE_COMPRESSOR) effects.addEffect(eq);
+  truePeak.begin(copier.bufferSize() / (channels * 2), channels); // allocates for the copied blocks
+  effects.addEffect(truePeak);  // must be before compressor and dynamics
   effects.addEffect(compressor);
+  compressor.setDetector(&truePeak);
+  compressor.setStereoLink(STEREO_LINK);
+#if SIDECHAIN && !defined(TOS_LINK)
+  compressor.setKeyStream(&out, channels); // same clocks as the DAC: read in lockstep with the blocks
+#endif
+  compressor.setActive(!DYNAMICS);
+  dynamics.setExpander(-50, 2); // 1:2 below -50 dBFS
+  dynamics.setLimiter(-1);      // ceiling -1 dBFS
+  dynamics.setDetector(&truePeak); // true-peak limiter with TRUE_PEAK
+  dynamics.setActive(DYNAMICS);
+  effects.addEffect(dynamics);
+  statistics.setActive(AUTO_THRESHOLD); // output of the compressor
+  effects.addEffect(statistics);
+  if (!EQ_BEFORE_COMPRESSOR) effects.addEffect(eq);
+  effects.addEffect(loudness); // must be before makeup
+  makeup.setTarget((float)targetLufs);
+  makeup.setActive(AUTO_MAKEUP || AUTO_THRESHOLD);
+  effects.addEffect(makeup);
   effects.begin(info);
+  effects.setIdleAfter(IDLE_AFTER * 1000);
+  AutoThresholdConfig autoConfig;
+  autoConfig.targetCrestDb = TARGET_CREST;
+  autoConfig.minThreshold = autoMin;
+  autoConfig.maxThreshold = autoMax;
+  autoConfig.makeupShare = AUTO_MAKEUP ? 0.0f : 0.5f; // AUTO_MAKEUP has the makeup
+  autoThreshold.begin(statistics, autoConfig);
+  if (SPECTRUM > 0 && spectrum.begin(sample_rate, SPECTRUM, SPECTRUM_EVERY)) effects.setTap(&tap);
   updateValues();
   Serial.println("Compressor started");
+
+  // Den Task im Setup erstellen und an Core 0 "pinnen": erst zum Schluss, ab hier ändert nur
+  // noch Core 0 die Einstellungen der Effekte (auch die IR Befehle, siehe controlWork())
+  xTaskCreatePinnedToCore(
+      httpTaskCode,    /* Name der Funktion (Task) */
+      "HttpCore0",     /* Task-Name */
+      8192,            /* Stack-Größe (RAM) – 8K ist ein sicherer Wert */
+      NULL,            /* Parameter */
+      2,               /* Priorität (etwas höher als Standard-1) */
+      &TaskCore0,      /* Task Handle */
+      0);              /* <-- Core ID 0 */
 }
 
 // Arduino loop - copy data
 void loop() {
-  copier.copy();
-  // comment out if using original AudioEffects.h
+  size_t copied = copier.copy();
+  if (DYNAMICS) history.append(copied / (channels * 2), dynamics.inputPeak(), dynamics.outputPeak(), 
+                               dynamics.gainReductionDb(), truePeak.truePeak());
+  else history.append(copied / (channels * 2), compressor.inputPeak(), compressor.outputPeak(), 
+                      compressor.gainReductionDb(), truePeak.truePeak());
+  if (AUTO_THRESHOLD && !effects.isIdle())
+    statistics.addGainReduction(DYNAMICS ? dynamics.gainReductionDb() : compressor.gainReductionDb());
+  // adapt the output buffers to the measured underruns
+  static uint32_t lastLoop = micros();
+  uint32_t now = micros();
+  if (latency.update(now - lastLoop, effects.processingTime(), copier.bufferSize() / (channels * 2))) {
+    paced.setLimit(latency.bufferCount() * latency.bufferFrames()); // the output keeps running
+  }
+  lastLoop = now;
+  // idle mode: the first block with signal is already processed, the clock follows
+  static bool idle = false;
+  if (effects.isIdle() != idle) {
+    idle = effects.isIdle();
+    setCpuFrequencyMhz(idle ? 80 : 240); // APB stays at 80 MHz: I2S and SPDIF keep running
+    Serial.println(idle ? "==> idle: silence" : "==> signal");
+  }
+#ifdef BENCHMARK
+  static uint32_t blocks = 0, blockTime = 0;
+  blockTime += effects.processingTime();
+  if (++blocks == 1000) {
+    char msg[120];
+    snprintf(msg, 120, "==> %lu us per block, true-peak %.1f dBTP, %.1f LUFS, makeup %.1f dB", (unsigned long)(blockTime / blocks), 
+             truePeak.maxTruePeakDb(), loudness.shortTerm(), makeup.gainDb());
+    Serial.println(msg);
+    blocks = blockTime = 0;
+  }
+#endif
+  // gain reduction LEDs
   if (Compressor_Active1) digitalWrite(LED_GRN, HIGH); else digitalWrite(LED_GRN, LOW); 
   if (Compressor_Active2) digitalWrite(LED_RED, HIGH); else if (!IRledIsOn) digitalWrite(LED_RED, LOW); 
-  int tdelta = 0;
-  if (IR_getButton(tdelta)) IR_SetThreshold(tdelta); 
+  // the IR commands are only passed to core 0
+  int tdelta = 0, preset = -1;
+  if (IR_getButton(tdelta, preset)) {
+    if (preset >= 0) irPreset.store(preset);
+    else irDelta += tdelta;
+  }
 }
@@ -0,0 +1,96 @@
+/*
+ * @brief Fast approximations of log2, exp2, dB conversions, tanh and the reciprocal
+ * for the audio loop: libm versions of these functions are slow on the ESP32.
+ * All functions are branch-free (except clamping) and can be vectorized.
+ * Maximum errors (measured on the host against libm over the range of the arguments, see
+ * sim/fastmath_test.cpp):
+ *   fast_log2          absolute 1.6e-5   (1e-30 .. 1e30)
+ *   fast_linear_to_db  absolute 1.3e-4 dB
+ *   fast_exp2          relative 2.9e-7   (-126 .. 127)
+ *   fast_db_to_linear  relative 1.4e-6   (-120 .. 120 dB)
+ *   fast_tanh          absolute 9.7e-5
+ *   fast_reciprocal    relative 6.7e-6
+ * @author W. Voigt
+ * @copyright GPLv3
+ */
+
+#pragma once
+#include <stdint.h>
+#include <string.h>
+
+namespace audio_tools {
+
+inline uint32_t fast_float_bits(float value) {
+  uint32_t result;
+  memcpy(&result, &value, sizeof(result));
+  return result;
+}
+
+inline float fast_bits_float(uint32_t bits) {
+  float result;
+  memcpy(&result, &bits, sizeof(result));
+  return result;
+}
+
+/// log2(1+t)/t for t in [0, 1): minimax polynomial of degree 5
+constexpr float fast_log2_poly(float t) {
+  return 1.4426848f + t * (-0.720519793f + t * (0.469920691f + t * (-0.305122162f +
+         t * (0.148413017f + t * -0.0353867922f))));
+}
+
+/// (2^f - 1)/f for f in [0, 1): minimax polynomial of degree 4
+constexpr float fast_exp2_poly(float f) {
+  return 0.693147588f + f * (0.240206549f + f * (0.0556602867f + f * (0.00919420752f +
+         f * 0.00179096179f)));
+}
+
+/// log2(x) for x > 0 (normalized floats): absolute error < 1.6e-5
+inline float fast_log2(float x) {
+  uint32_t bits = fast_float_bits(x);
+  float exponent = (float)((int32_t)((bits >> 23) & 0xFF) - 127);
+  float t = fast_bits_float((bits & 0x007FFFFF) | 0x3F800000) - 1.0f;
+  return exponent + t * fast_log2_poly(t);
+}
+
+/// 2^x for x in [-126, 127] (clamped): relative error < 2.9e-7
+inline float fast_exp2(float x) {
+  if (x < -126.0f) x = -126.0f;
+  if (x > 127.0f) x = 127.0f;
+  // floor without libm
+  int32_t i = (int32_t)x;
+  i -= (x < (float)i);
+  float f = x - (float)i;
+  float scale = fast_bits_float((uint32_t)(i + 127) << 23);
+  return scale * (1.0f + f * fast_exp2_poly(f));
+}
+
+/// x^y for x > 0
+inline float fast_pow(float x, float y) { return fast_exp2(y * fast_log2(x)); }
+
+/// dB to linear factor: relative error < 1.4e-6
+inline float fast_db_to_linear(float db) {
+  return fast_exp2(db * 0.166096405f); // log2(10) / 20
+}
+
+/// linear factor (> 0) to dB: absolute error < 1.3e-4 dB
+inline float fast_linear_to_db(float value) {
+  return 6.02059991f * fast_log2(value); // 20 * log10(2)
+}
+
+/// tanh(x) with a [7/6] Pade approximation, clamped to +-1 outside +-4.97:
+/// absolute error < 9.7e-5
+constexpr float fast_tanh(float x) {
+  return x >= 4.97f ? 1.0f : x <= -4.97f ? -1.0f :
+         x * (135135.0f + x * x * (17325.0f + x * x * (378.0f + x * x))) /
+         (135135.0f + x * x * (62370.0f + x * x * (3150.0f + x * x * 28.0f)));
+}
+
+/// 1/x for normalized floats with two Newton iterations: relative error < 6.7e-6
+inline float fast_reciprocal(float x) {
+  float y = fast_bits_float(0x7EF311C7u - fast_float_bits(x));
+  y = y * (2.0f - x * y);
+  y = y * (2.0f - x * y);
+  return y;
+}
+
+} // namespace audio_tools
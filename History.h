@@ -0,0 +1,108 @@
+// Gain reduction history for tuning attack and release on real broadcasts
+// The audio core appends one fixed size record per block into a ring buffer in PSRAM
+// (several minutes), the control core serves it as binary data via GET /api/history.
+// Decode it on the host with tools/decode_history.py (CSV export or plot).
+// Levels are stored in 0.01 dB: HISTORY_NONE = not available (e.g. true-peak is off).
+
+#define HISTORY_VERSION 1
+#define HISTORY_NONE INT16_MIN
+
+struct HistoryRecord {
+  uint16_t frames;  // frames of the block
+  int16_t input;    // peak before the compressor in 0.01 dBFS
+  int16_t output;   // peak after the compressor in 0.01 dBFS
+  int16_t gain;     // smallest gain of the block in 0.01 dB
+  int16_t truePeak; // true-peak of the input in 0.01 dBTP
+};
+
+// Header of the binary download, followed by count records (little endian)
+struct HistoryHeader {
+  char magic[4] = {'G', 'R', 'H', 'S'};
+  uint16_t version = HISTORY_VERSION;
+  uint16_t recordSize = sizeof(HistoryRecord);
+  uint32_t sampleRate = 0;
+  uint32_t first = 0;  // number of the first record since the start
+  uint32_t count = 0;
+};
+
+class HistoryRecorder {
+  public:
+    /// allocates the ring buffer for the indicated seconds: in PSRAM if available,
+    /// otherwise internal RAM for a short history only
+    bool begin(uint32_t sampleRate, float seconds, int blockFrames, float internalSeconds = 10) {
+      sample_rate = sampleRate;
+      if (!psramFound()) seconds = internalSeconds;
+      capacity = seconds * sampleRate / blockFrames;
+      // records which may be overwritten while a download is sent
+      guard = capacity / 8;
+      size_t size = capacity * sizeof(HistoryRecord);
+      p_records = (HistoryRecord *)(psramFound() ? ps_malloc(size) : malloc(size));
+      if (p_records == nullptr) capacity = 0;
+      written.store(0);
+      return p_records != nullptr;
+    }
+
+    /// called by the audio core after each block: linear peaks (true-peak <= 0 = not available)
+    /// and the gain in dB
+    void append(int frames, float inputPeak, float outputPeak, float gainDb, float truePeak = 0) {
+      if (capacity == 0 || frames <= 0) return;
+      uint32_t index = written.load(std::memory_order_relaxed);
+      HistoryRecord &record = p_records[index % capacity];
+      record.frames = frames;
+      record.input = centiDb(linearToDb(inputPeak));
+      record.output = centiDb(linearToDb(outputPeak));
+      record.gain = centiDb(gainDb);
+      record.truePeak = truePeak > 0 ? centiDb(linearToDb(truePeak)) : HISTORY_NONE;
+      written.store(index + 1, std::memory_order_release);
+    }
+
+    /// determines the records which can be downloaded: the guard area are the OLDEST records,
+    /// the audio core overwrites them next while the download is sent, so they are left out
+    /// on purpose; the newest record is always included
+    HistoryHeader header() {
+      HistoryHeader result;
+      uint32_t end = written.load(std::memory_order_acquire);
+      uint32_t count = capacity - guard;
+      if (count > end) count = end;
+      result.sampleRate = sample_rate;
+      result.first = end - count;
+      result.count = count;
+      return result;
+    }
+
+    /// writes the records of the header: returns the number of bytes
+    size_t write(Print &out, const HistoryHeader &header) {
+      size_t result = 0;
+      uint32_t index = header.first;
+      uint32_t remaining = header.count;
+      while (remaining > 0) {
+        uint32_t pos = index % capacity;
+        uint32_t len = capacity - pos;
+        if (len > remaining) len = remaining;
+        result += out.write((const uint8_t *)&p_records[pos], len * sizeof(HistoryRecord));
+        index += len;
+        remaining -= len;
+      }
+      return result;
+    }
+
+    /// number of records which fit into the buffer
+    uint32_t size() { return capacity; }
+
+  protected:
+    HistoryRecord *p_records = nullptr;
+    uint32_t capacity = 0;
+    uint32_t guard = 0;
+    uint32_t sample_rate = 44100;
+    std::atomic<uint32_t> written{0};
+
+    static float linearToDb(float value) {
+      return value > 0.0f ? fast_linear_to_db(value) : -120.0f;
+    }
+
+    static int16_t centiDb(float db) {
+      if (db < -120.0f) db = -120.0f;
+      else if (db > 120.0f) db = 120.0f;
+      return (int16_t)lroundf(db * 100.0f);
+    }
+};
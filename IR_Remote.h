@@ -1,7 +1,7 @@
 // Source: Examples - IRremote - SimpleReceiver
 // from Arduino-IRremote https://github.com/Arduino-IRremote/Arduino-IRremote.
 
-// We use the IR Remote to increase / decrease the Limiter Threshold.
+// We use the IR Remote to increase / decrease the Limiter Threshold and to select the presets.
 // To find out your IR Protocol and Codes:
 // Flash IR-SimpleReceiver, watch Serial monitor and press desired buttons on the IR Remote.
 // Define the Protocol (#define DECODE_xxx) which is declared in IR-SimpleReceiver.ino
@@ -25,9 +25,10 @@ bool IR_begin()  {
   return true;
 }
 
-bool IR_getButton(int &tdelta)
+bool IR_getButton(int &tdelta, int &preset)
 {
   tdelta = 0;
+  preset = -1;
   bool found = false;
   if (IrReceiver.decode()) {
     // Print a summary of received data
@@ -47,6 +48,8 @@ bool IR_getButton(int &tdelta)
         tdelta = 5; found = true;
     } else if ((IrReceiver.decodedIRData.command == 0x8F) || (IrReceiver.decodedIRData.command == 0x9F)) { // Threshold <
         tdelta = -5; found = true;
+    } else if ((IrReceiver.decodedIRData.command >= 0x11) && (IrReceiver.decodedIRData.command < 0x11 + PRESET_COUNT)) { // Taste 1, 2, 3: Presets
+        preset = IrReceiver.decodedIRData.command - 0x11; found = true;
     }
     if (found) {
       IRledIsOn = true;
@@ -0,0 +1,203 @@
+// Adaptive buffer depth of the output for a low lip-sync delay
+// The controller measures the duration of each loop and the processing time of each block.
+// A loop which takes longer than the output buffers can bridge means an underrun.
+// Without underruns the buffer depth is reduced step by step, after an underrun it is
+// increased again and not reduced for a longer hold time (hysteresis).
+// The depth is only a limit of the filling of the DMA buffers (PacedOutput): the output keeps
+// running, so a change is inaudible.
+// The measured latency = buffered input + queued output frames + processing of one block.
+
+class LatencyController {
+  public:
+    /// frames of one output buffer, min and max number of output buffers
+    void begin(float sampleRate, int bufferFrames, int minCount, int maxCount, int startCount) {
+      sample_rate = sampleRate;
+      buffer_frames = bufferFrames;
+      min_count = minCount;
+      max_count = maxCount;
+      count = startCount;
+      floor_count = minCount;
+      window_start = hold_until = millis();
+    }
+
+    /// enables the reduction of the buffer depth
+    void setActive(bool active) { is_active = active; }
+
+    bool active() { return is_active; }
+
+    /// time in ms without underruns before the depth is reduced
+    void setWindow(uint32_t ms) { window_ms = ms; }
+
+    /// call after each block: returns true if the buffer count was changed
+    bool update(uint32_t loopUs, uint32_t processUs, float blockFrames) {
+      uint32_t block_us = 1000000.0f * blockFrames / sample_rate;
+      margin_us = (int32_t)block_us - (int32_t)processUs;
+      if (margin_us < min_margin_us) min_margin_us = margin_us;
+      if (loopUs > bufferUs(count)) {
+        underruns++;
+        window_underruns++;
+      }
+      if (!is_active) return false;
+
+      uint32_t now = millis();
+      if (window_underruns > 0) {
+        // back off: more buffers and no reduction below this depth for the hold time
+        window_underruns = 0;
+        window_start = now;
+        hold_until = now + hold_ms;
+        if (count < max_count) {
+          floor_count = count + 1;
+          count++;
+          return true;
+        }
+        return false;
+      }
+      if (now - window_start < window_ms) return false;
+      window_start = now;
+      if ((int32_t)(now - hold_until) >= 0) floor_count = min_count;
+      if (count > floor_count) {
+        count--;
+        return true;
+      }
+      return false;
+    }
+
+    /// actual number of output buffers
+    int bufferCount() { return count; }
+
+    int bufferFrames() { return buffer_frames; }
+
+    /// latency from input to output in ms: the frames are measured (e.g. PacedOutput::queuedFrames())
+    float latencyMs(float inputFrames, float outputFrames, uint32_t processUs) {
+      return 1000.0f * (inputFrames + outputFrames) / sample_rate + processUs / 1000.0f;
+    }
+
+    /// remaining time of the last block in us
+    int32_t margin() { return margin_us; }
+
+    /// smallest remaining time since the last reset in us
+    int32_t minMargin() { return min_margin_us; }
+
+    uint32_t underrunCount() { return underruns; }
+
+    void resetStatistics() {
+      min_margin_us = INT32_MAX;
+      underruns = 0;
+    }
+
+  protected:
+    float sample_rate = 44100;
+    int buffer_frames = 128;
+    int min_count = 2, max_count = 8, count = 8, floor_count = 2;
+    bool is_active = true;
+    uint32_t window_ms = 10000;
+    uint32_t hold_ms = 120000;
+    uint32_t window_start = 0, hold_until = 0;
+    int32_t margin_us = 0;
+    int32_t min_margin_us = INT32_MAX;
+    uint32_t underruns = 0;
+    int window_underruns = 0;
+
+    /// time which is bridged by the output buffers in us
+    uint32_t bufferUs(int bufferCount) {
+      return 1000000.0f * bufferCount * buffer_frames / sample_rate;
+    }
+};
+
+// Output which limits the filling of the DMA buffers below their capacity
+// The I2S and SPDIF output do not report their filling (availableForWrite() is constant), so it is
+// calculated with micros(): the output clock is derived from the same crystal. A write which blocks
+// returns when a DMA buffer is free and corrects the calculation: with the full depth each write
+// blocks. An interrupt after the return looks like a fuller queue, so the calculation is raised in
+// small steps only. A lower limit delays the next write, the output plays the queued frames meanwhile.
+
+class PacedOutput : public Print {
+  public:
+    PacedOutput(Print &out) : out(out) {}
+
+    /// capacity of the DMA buffers in frames
+    void begin(uint32_t sampleRate, int frameSize, int capacityFrames) {
+      sample_rate = sampleRate;
+      frame_size = frameSize;
+      capacity = limit = capacityFrames;
+      is_synced = false;
+    }
+
+    /// max queued frames after a write
+    void setLimit(int frames) { limit = frames < capacity ? frames : capacity; }
+
+    int limitFrames() { return limit; }
+
+    size_t write(const uint8_t *data, size_t len) override {
+      int frames = len / frame_size;
+      uint32_t now = micros();
+      if (is_synced) {
+        double queued = queuedAt(now);
+        if (queued < 0.0) {
+          // underrun: the output played silence
+          underruns++;
+          sync(now, 0.0);
+          queued = 0.0;
+        }
+        double wait = queued + frames - limit;
+        if (limit < capacity && wait > 0.0) {
+          uint32_t wait_us = 1000000.0 * wait / sample_rate;
+          if (wait_us >= 1000) delay(wait_us / 1000);
+          delayMicroseconds(wait_us % 1000);
+          now = micros();
+          queued = queuedAt(now);
+        }
+        queued_frames = queued;
+      }
+      size_t result = out.write(data, len);
+      uint32_t end = micros();
+      double full = capacity - frames;
+      if (!is_synced) {
+        if (end - now > blocked_us) {
+          sync(end, full);
+          queued_frames = full;
+        }
+      } else {
+        double queued = queuedAt(end);
+        if (end - now > blocked_us && queued < full - raise_step) sync(end, queued + raise_step);
+        else if (end - now > blocked_us || queued > full) sync(end, full);
+      }
+      queued_units += (int64_t)(result / frame_size) * 1000000;
+      return result;
+    }
+
+    int availableForWrite() override { return out.availableForWrite(); }
+
+    /// queued frames before the last write
+    float queuedFrames() { return queued_frames; }
+
+    /// underruns which were detected by the calculation
+    uint32_t underrunCount() { return underruns; }
+
+  protected:
+    Print &out;
+    uint32_t sample_rate = 44100;
+    int frame_size = 4;
+    int capacity = 1024, limit = 1024;
+    const uint32_t blocked_us = 200; // a write which took longer blocked
+    const int raise_step = 8;        // frames per blocking write
+    bool is_synced = false;
+    uint32_t last_us = 0;
+    int64_t queued_units = 0;   // queued frames * 1000000: exact sums of integers
+    float queued_frames = 0.0f;
+    uint32_t underruns = 0;
+
+    /// the output had the queued frames at the time
+    void sync(uint32_t now, double queued) {
+      last_us = now;
+      queued_units = (int64_t)(queued * 1000000.0);
+      is_synced = true;
+    }
+
+    /// queued frames at the time: micros() may wrap around
+    double queuedAt(uint32_t now) {
+      queued_units -= (int64_t)(uint32_t)(now - last_us) * sample_rate;
+      last_us = now;
+      return queued_units * 1e-6;
+    }
+};
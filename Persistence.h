@@ -0,0 +1,151 @@
+// Deferred persistence of the settings
+// NVS flash writes disable the flash cache and stall both cores, which leads to SPDIF dropouts.
+// Therefore the settings are only marked dirty on each change and the changes are coalesced:
+// they are written after a quiet period (preferably during silence) or on explicit save.
+// The storage is behind the interface PersistenceBackend: MemoryBackend can be used for tests on the host.
+
+// Interface for the storage of binary blobs
+class PersistenceBackend {
+  public:
+    virtual ~PersistenceBackend() = default;
+    /// stores the data: returns false on error
+    virtual bool write(const char *key, const void *data, size_t len) = 0;
+    /// provides the stored data: returns the number of bytes or 0 if the key does not exist
+    virtual size_t read(const char *key, void *data, size_t len) = 0;
+};
+
+// Storage in NVS flash with the ESP32 Preferences
+class PreferencesBackend : public PersistenceBackend {
+  public:
+    PreferencesBackend(Preferences &prefs, const char *name) : prefs(prefs), name(name) {}
+
+    bool write(const char *key, const void *data, size_t len) override {
+      if (!prefs.begin(name, false)) return false;
+      bool result = prefs.putBytes(key, data, len) == len;
+      prefs.end();
+      return result;
+    }
+
+    size_t read(const char *key, void *data, size_t len) override {
+      if (!prefs.begin(name, true)) return 0;
+      size_t result = 0;
+      if (prefs.getBytesLength(key) == len) result = prefs.getBytes(key, data, len);
+      prefs.end();
+      return result;
+    }
+
+  protected:
+    Preferences &prefs;
+    const char *name;
+};
+
+// Storage in RAM e.g. for tests on the host
+class MemoryBackend : public PersistenceBackend {
+  public:
+    static const int max_entries = 4;
+    static const int max_size = 256;
+
+    bool write(const char *key, const void *data, size_t len) override {
+      if (len > max_size) return false;
+      Entry *entry = find(key);
+      if (entry == nullptr) {
+        if (count >= max_entries) return false;
+        entry = &entries[count++];
+        strncpy(entry->key, key, sizeof(entry->key) - 1);
+      }
+      memcpy(entry->data, data, len);
+      entry->len = len;
+      writes++;
+      return true;
+    }
+
+    size_t read(const char *key, void *data, size_t len) override {
+      Entry *entry = find(key);
+      if (entry == nullptr || entry->len != len) return 0;
+      memcpy(data, entry->data, len);
+      return len;
+    }
+
+    /// number of write operations e.g. to check the coalescing
+    int writeCount() { return writes; }
+
+  protected:
+    struct Entry {
+      char key[16] = {0};
+      uint8_t data[max_size];
+      size_t len = 0;
+    } entries[max_entries];
+    int count = 0;
+    int writes = 0;
+
+    Entry *find(const char *key) {
+      for (int j = 0; j < count; j++) {
+        if (strcmp(entries[j].key, key) == 0) return &entries[j];
+      }
+      return nullptr;
+    }
+};
+
+// Marks the settings dirty and writes them to the backend when it fits best
+class PersistenceManager {
+  public:
+    PersistenceManager(PersistenceBackend &backend, const char *key, const void *data, size_t len)
+      : backend(backend), key(key), p_data(data), len(len) {}
+
+    /// quiet period in ms after the last change, when signal is present
+    void setQuietPeriod(uint32_t ms) { quiet_ms = ms; }
+
+    /// quiet period in ms after the last change, when the audio is silent
+    void setSilentPeriod(uint32_t ms) { silent_ms = ms; }
+
+    /// the settings were changed: only marks them dirty
+    void markDirty(uint32_t nowMs) {
+      dirty = true;
+      last_change_ms = nowMs;
+    }
+
+    /// requests to write the settings with the next update()
+    void save() { save_requested = true; }
+
+    bool isDirty() { return dirty; }
+
+    /// call regularly from the control core: returns true if the settings were written
+    bool update(uint32_t nowMs, bool silent) {
+      if (!dirty && !save_requested) return false;
+      uint32_t quiet = nowMs - last_change_ms;
+      if (!save_requested && quiet < (silent ? silent_ms : quiet_ms)) return false;
+      return commit();
+    }
+
+    /// writes the settings immediately
+    bool commit() {
+      uint32_t start = micros();
+      bool result = backend.write(key, p_data, len);
+      commit_us = micros() - start;
+      commits++;
+      if (result) {
+        dirty = false;
+        save_requested = false;
+      }
+      return result;
+    }
+
+    /// duration of the last commit in us
+    uint32_t lastCommitTime() { return commit_us; }
+
+    /// number of commits
+    uint32_t commitCount() { return commits; }
+
+  protected:
+    PersistenceBackend &backend;
+    const char *key;
+    const void *p_data;
+    size_t len;
+    bool dirty = false;
+    bool save_requested = false;
+    uint32_t last_change_ms = 0;
+    uint32_t quiet_ms = 30000;
+    uint32_t silent_ms = 1000;
+    uint32_t commit_us = 0;
+    uint32_t commits = 0;
+};
@@ -0,0 +1,80 @@
+// Presets for the Compressor, e.g. "night", "movie" and "music"
+// All settings are stored as one binary blob in the Preferences (key "settings").
+// Requires Persistence.h
+// The coefficients of each preset are calculated when the presets are loaded,
+// so switching a preset (e.g. by IR Remote) is only a pointer swap on the audio core.
+
+#define PRESET_COUNT 3
+#define PRESET_VERSION 3
+
+struct Preset {
+  char name[8];
+  uint8_t ratio;
+  uint8_t threshold;     // in %
+  uint8_t mix;           // compressed part in % (parallel compression)
+  uint16_t attackTime;   // in ms
+  uint16_t releaseTime;  // in ms
+};
+
+// Blob which is stored in the Preferences
+struct PresetBlob {
+  uint8_t version = PRESET_VERSION;
+  int8_t selected = -1;      // active preset or -1 for the actual values
+  Preset actual;             // values of the web interface
+  uint8_t autoMin = 10;      // bounds of the automatic threshold in %
+  uint8_t autoMax = 60;
+  Preset presets[PRESET_COUNT] = {
+    {"night", 200, 20, 100, 5, 1000},
+    {"movie", 100, 30, 100, 10, 500},
+    {"music", 20, 60, 70, 20, 300},
+  };
+};
+
+PresetBlob presetBlob;
+// two copies of the coefficients per preset: a changed preset is published as a new object,
+// the audio core may still use the old one until its next block
+CompressorSettings presetSettings[2][PRESET_COUNT];
+uint8_t presetCopy[PRESET_COUNT] = {0};  // published copy of each preset
+
+// calculates the coefficients of the preset into the unused copy and publishes it
+const CompressorSettings *Preset_calculate(int slot, float sampleRate) {
+  Preset &p = presetBlob.presets[slot];
+  int copy = presetCopy[slot] ^ 1;
+  presetSettings[copy][slot] = Compressor::calculateSettings(sampleRate, p.attackTime, p.releaseTime, p.threshold, p.ratio, p.mix);
+  presetCopy[slot] = copy;
+  return &presetSettings[copy][slot];
+}
+
+// loads the blob: returns false if it was not stored yet or has a different version
+// The blob is written by the PersistenceManager (see Persistence.h)
+bool Preset_load(PersistenceBackend &storage, float sampleRate) {
+  PresetBlob blob;
+  bool result = storage.read("settings", &blob, sizeof(PresetBlob)) == sizeof(PresetBlob)
+                && blob.version == PRESET_VERSION;
+  if (result) presetBlob = blob;
+  for (int j = 0; j < PRESET_COUNT; j++) Preset_calculate(j, sampleRate);
+  return result;
+}
+
+// stores the actual values in the preset slot: if it is selected, the compressor gets the new
+// coefficients, the old copy is only overwritten by the next change of this slot
+bool Preset_store(int slot, float sampleRate, Compressor &compressor) {
+  if (slot < 0 || slot >= PRESET_COUNT) return false;
+  Preset &p = presetBlob.presets[slot];
+  p.ratio = presetBlob.actual.ratio;
+  p.threshold = presetBlob.actual.threshold;
+  p.mix = presetBlob.actual.mix;
+  p.attackTime = presetBlob.actual.attackTime;
+  p.releaseTime = presetBlob.actual.releaseTime;
+  const CompressorSettings *p_settings = Preset_calculate(slot, sampleRate);
+  if (presetBlob.selected == slot) compressor.setSettings(p_settings);
+  return true;
+}
+
+// activates the preset slot: the compressor only swaps the pointer
+bool Preset_select(int slot, Compressor &compressor) {
+  if (slot < 0 || slot >= PRESET_COUNT) return false;
+  presetBlob.selected = slot;
+  compressor.setSettings(&presetSettings[presetCopy[slot]][slot]);
+  return true;
+}
@@ -0,0 +1,152 @@
+// Spectrum analyser of the web interface: before and after the compressor
+// The audio core only copies every n-th block into the AudioTap of the effects stream.
+// The control core calculates the spectra with a real FFT (256 - 1024 points, Hann window,
+// tables in flash from tools/make_fft_tables.py) and averages them exponentially.
+// GET /api/spectrum serves them as binary frame: levels in 0.5 dB steps, one byte per bin.
+
+#include <SpectrumTables.h>
+
+#define SPECTRUM_VERSION 1
+
+// Header of the binary frame, followed by bins bytes of the input and bins bytes of the output.
+// Level of a bin in dBFS = value / 2 - 127.5 (sine)
+struct SpectrumHeader {
+  char magic[4] = {'S', 'P', 'E', 'C'};
+  uint16_t version = SPECTRUM_VERSION;
+  uint16_t bins = 0;        // fft size / 2, bin j has the frequency j * sampleRate / fft size
+  uint32_t sampleRate = 0;
+  uint32_t count = 0;       // number of analysed slots since the start
+};
+
+class SpectrumAnalyzer {
+  public:
+    SpectrumAnalyzer(AudioTap &tap) : tap(tap) {}
+
+    /// fftSize: 256, 512 or 1024; averaging: weight of a new spectrum (1 = no averaging)
+    bool begin(uint32_t sampleRate, int fftSize, int everyBlocks, float averaging = 0.3f) {
+      if (fftSize < 256 || fftSize > SPECTRUM_TABLE_SIZE || (fftSize & (fftSize - 1)) != 0) return false;
+      sample_rate = sampleRate;
+      fft_size = fftSize;
+      weight = averaging;
+      count = 0;
+      for (int j = 0; j < SPECTRUM_TABLE_SIZE / 2; j++) {
+        average[0][j] = average[1][j] = 0.0f;
+      }
+      tap.begin(fftSize, everyBlocks);
+      return true;
+    }
+
+    /// control core: analyses the copied blocks, returns their number
+    int update() {
+      int result = 0;
+      const AudioTap::Slot *p_slot;
+      while (fft_size > 0 && (p_slot = tap.front()) != nullptr) {
+        analyse(p_slot->input, average[0]);
+        analyse(p_slot->output, average[1]);
+        tap.release();
+        count++;
+        result++;
+      }
+      return result;
+    }
+
+    SpectrumHeader header() {
+      SpectrumHeader result;
+      result.bins = fft_size / 2;
+      result.sampleRate = sample_rate;
+      result.count = count;
+      return result;
+    }
+
+    /// writes the header and the levels: same task as update(), so nothing changes meanwhile
+    size_t write(Print &out) {
+      SpectrumHeader head = header();
+      size_t result = out.write((const uint8_t *)&head, sizeof(head));
+      uint8_t levels[SPECTRUM_TABLE_SIZE / 2];
+      for (int spectrum = 0; spectrum < 2; spectrum++) {
+        for (int j = 0; j < head.bins; j++) {
+          levels[j] = level(average[spectrum][j]);
+        }
+        result += out.write(levels, head.bins);
+      }
+      return result;
+    }
+
+    /// bytes of write()
+    size_t size() { return sizeof(SpectrumHeader) + fft_size; }
+
+  protected:
+    AudioTap &tap;
+    uint32_t sample_rate = 44100;
+    int fft_size = 0;
+    float weight = 0.3f;
+    uint32_t count = 0;
+    float average[2][SPECTRUM_TABLE_SIZE / 2];  // power: 1 = full scale sine
+    float re[SPECTRUM_TABLE_SIZE / 2], im[SPECTRUM_TABLE_SIZE / 2];
+
+    /// power spectrum of fft_size frames: real FFT with a complex FFT of half the size
+    void analyse(const int16_t *data, float *result) {
+      int half = fft_size / 2;
+      int step = SPECTRUM_TABLE_SIZE / fft_size;
+      // even samples as real part, odd samples as imaginary part
+      for (int j = 0; j < half; j++) {
+        re[j] = data[2 * j] * fftWindow[2 * j * step];
+        im[j] = data[2 * j + 1] * fftWindow[(2 * j + 1) * step];
+      }
+      fft(half);
+      // full scale sine: |X| = 32767 * fft_size / 4 with the Hann window
+      float scale = 4.0f / (32767.0f * fft_size);
+      scale *= scale;
+      for (int k = 0; k < half; k++) {
+        int m = k == 0 ? 0 : half - k;
+        // X[k] = E + W^k * O with E = (Z[k] + Z*[m]) / 2 and O = (Z[k] - Z*[m]) / 2i
+        float er = 0.5f * (re[k] + re[m]), ei = 0.5f * (im[k] - im[m]);
+        float or_ = 0.5f * (im[k] + im[m]), oi = -0.5f * (re[k] - re[m]);
+        float wr = fftCos[k * step], wi = -fftSin[k * step];
+        float xr = er + wr * or_ - wi * oi;
+        float xi = ei + wr * oi + wi * or_;
+        float power = (xr * xr + xi * xi) * scale;
+        result[k] += weight * (power - result[k]);
+      }
+    }
+
+    /// in-place radix-2 FFT of n complex values with the twiddles of the table
+    void fft(int n) {
+      for (int j = 1, k = 0; j < n; j++) {
+        int bit = n >> 1;
+        for (; k & bit; bit >>= 1) k ^= bit;
+        k ^= bit;
+        if (j < k) {
+          float tr = re[j], ti = im[j];
+          re[j] = re[k];
+          im[j] = im[k];
+          re[k] = tr;
+          im[k] = ti;
+        }
+      }
+      for (int len = 2; len <= n; len <<= 1) {
+        int half_len = len / 2;
+        int stride = SPECTRUM_TABLE_SIZE / len;
+        for (int start = 0; start < n; start += len) {
+          for (int k = 0; k < half_len; k++) {
+            float wr = fftCos[k * stride], wi = -fftSin[k * stride];
+            int a = start + k, b = a + half_len;
+            float tr = re[b] * wr - im[b] * wi;
+            float ti = re[b] * wi + im[b] * wr;
+            re[b] = re[a] - tr;
+            im[b] = im[a] - ti;
+            re[a] += tr;
+            im[a] += ti;
+          }
+        }
+      }
+    }
+
+    static uint8_t level(float power) {
+      float db = power > 0.0f ? 3.01029996f * fast_log2(power) : -200.0f; // 10 * log10(2)
+      float value = (db + 127.5f) * 2.0f;
+      if (value < 0.0f) return 0;
+      if (value > 255.0f) return 255;
+      return (uint8_t)(value + 0.5f);
+    }
+};
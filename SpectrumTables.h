@@ -0,0 +1,269 @@
+// Generated by tools/make_fft_tables.py - do not edit
+// FFT tables for up to 1024 points: smaller sizes use every n-th entry
+
+#define SPECTRUM_TABLE_SIZE 1024
+
+static const float fftCos[512] PROGMEM = {
+  1.000000000f, 0.999981175f, 0.999924702f, 0.999830582f, 0.999698819f, 0.999529418f, 0.999322385f, 0.999077728f,
+  0.998795456f, 0.998475581f, 0.998118113f, 0.997723067f, 0.997290457f, 0.996820299f, 0.996312612f, 0.995767414f,
+  0.995184727f, 0.994564571f, 0.993906970f, 0.993211949f, 0.992479535f, 0.991709754f, 0.990902635f, 0.990058210f,
+  0.989176510f, 0.988257568f, 0.987301418f, 0.986308097f, 0.985277642f, 0.984210092f, 0.983105487f, 0.981963869f,
+  0.980785280f, 0.979569766f, 0.978317371f, 0.977028143f, 0.975702130f, 0.974339383f, 0.972939952f, 0.971503891f,
+  0.970031253f, 0.968522094f, 0.966976471f, 0.965394442f, 0.963776066f, 0.962121404f, 0.960430519f, 0.958703475f,
+  0.956940336f, 0.955141168f, 0.953306040f, 0.951435021f, 0.949528181f, 0.947585591f, 0.945607325f, 0.943593458f,
+  0.941544065f, 0.939459224f, 0.937339012f, 0.935183510f, 0.932992799f, 0.930766961f, 0.928506080f, 0.926210242f,
+  0.923879533f, 0.921514039f, 0.919113852f, 0.916679060f, 0.914209756f, 0.911706032f, 0.909167983f, 0.906595705f,
+  0.903989293f, 0.901348847f, 0.898674466f, 0.895966250f, 0.893224301f, 0.890448723f, 0.887639620f, 0.884797098f,
+  0.881921264f, 0.879012226f, 0.876070094f, 0.873094978f, 0.870086991f, 0.867046246f, 0.863972856f, 0.860866939f,
+  0.857728610f, 0.854557988f, 0.851355193f, 0.848120345f, 0.844853565f, 0.841554977f, 0.838224706f, 0.834862875f,
+  0.831469612f, 0.828045045f, 0.824589303f, 0.821102515f, 0.817584813f, 0.814036330f, 0.810457198f, 0.806847554f,
+  0.803207531f, 0.799537269f, 0.795836905f, 0.792106577f, 0.788346428f, 0.784556597f, 0.780737229f, 0.776888466f,
+  0.773010453f, 0.769103338f, 0.765167266f, 0.761202385f, 0.757208847f, 0.753186799f, 0.749136395f, 0.745057785f,
+  0.740951125f, 0.736816569f, 0.732654272f, 0.728464390f, 0.724247083f, 0.720002508f, 0.715730825f, 0.711432196f,
+  0.707106781f, 0.702754744f, 0.698376249f, 0.693971461f, 0.689540545f, 0.685083668f, 0.680600998f, 0.676092704f,
+  0.671558955f, 0.666999922f, 0.662415778f, 0.657806693f, 0.653172843f, 0.648514401f, 0.643831543f, 0.639124445f,
+  0.634393284f, 0.629638239f, 0.624859488f, 0.620057212f, 0.615231591f, 0.610382806f, 0.605511041f, 0.600616479f,
+  0.595699304f, 0.590759702f, 0.585797857f, 0.580813958f, 0.575808191f, 0.570780746f, 0.565731811f, 0.560661576f,
+  0.555570233f, 0.550457973f, 0.545324988f, 0.540171473f, 0.534997620f, 0.529803625f, 0.524589683f, 0.519355990f,
+  0.514102744f, 0.508830143f, 0.503538384f, 0.498227667f, 0.492898192f, 0.487550160f, 0.482183772f, 0.476799230f,
+  0.471396737f, 0.465976496f, 0.460538711f, 0.455083587f, 0.449611330f, 0.444122145f, 0.438616239f, 0.433093819f,
+  0.427555093f, 0.422000271f, 0.416429560f, 0.410843171f, 0.405241314f, 0.399624200f, 0.393992040f, 0.388345047f,
+  0.382683432f, 0.377007410f, 0.371317194f, 0.365612998f, 0.359895037f, 0.354163525f, 0.348418680f, 0.342660717f,
+  0.336889853f, 0.331106306f, 0.325310292f, 0.319502031f, 0.313681740f, 0.307849640f, 0.302005949f, 0.296150888f,
+  0.290284677f, 0.284407537f, 0.278519689f, 0.272621355f, 0.266712757f, 0.260794118f, 0.254865660f, 0.248927606f,
+  0.242980180f, 0.237023606f, 0.231058108f, 0.225083911f, 0.219101240f, 0.213110320f, 0.207111376f, 0.201104635f,
+  0.195090322f, 0.189068664f, 0.183039888f, 0.177004220f, 0.170961889f, 0.164913120f, 0.158858143f, 0.152797185f,
+  0.146730474f, 0.140658239f, 0.134580709f, 0.128498111f, 0.122410675f, 0.116318631f, 0.110222207f, 0.104121634f,
+  0.098017140f, 0.091908956f, 0.085797312f, 0.079682438f, 0.073564564f, 0.067443920f, 0.061320736f, 0.055195244f,
+  0.049067674f, 0.042938257f, 0.036807223f, 0.030674803f, 0.024541229f, 0.018406730f, 0.012271538f, 0.006135885f,
+  0.000000000f, -0.006135885f, -0.012271538f, -0.018406730f, -0.024541229f, -0.030674803f, -0.036807223f, -0.042938257f,
+  -0.049067674f, -0.055195244f, -0.061320736f, -0.067443920f, -0.073564564f, -0.079682438f, -0.085797312f, -0.091908956f,
+  -0.098017140f, -0.104121634f, -0.110222207f, -0.116318631f, -0.122410675f, -0.128498111f, -0.134580709f, -0.140658239f,
+  -0.146730474f, -0.152797185f, -0.158858143f, -0.164913120f, -0.170961889f, -0.177004220f, -0.183039888f, -0.189068664f,
+  -0.195090322f, -0.201104635f, -0.207111376f, -0.213110320f, -0.219101240f, -0.225083911f, -0.231058108f, -0.237023606f,
+  -0.242980180f, -0.248927606f, -0.254865660f, -0.260794118f, -0.266712757f, -0.272621355f, -0.278519689f, -0.284407537f,
+  -0.290284677f, -0.296150888f, -0.302005949f, -0.307849640f, -0.313681740f, -0.319502031f, -0.325310292f, -0.331106306f,
+  -0.336889853f, -0.342660717f, -0.348418680f, -0.354163525f, -0.359895037f, -0.365612998f, -0.371317194f, -0.377007410f,
+  -0.382683432f, -0.388345047f, -0.393992040f, -0.399624200f, -0.405241314f, -0.410843171f, -0.416429560f, -0.422000271f,
+  -0.427555093f, -0.433093819f, -0.438616239f, -0.444122145f, -0.449611330f, -0.455083587f, -0.460538711f, -0.465976496f,
+  -0.471396737f, -0.476799230f, -0.482183772f, -0.487550160f, -0.492898192f, -0.498227667f, -0.503538384f, -0.508830143f,
+  -0.514102744f, -0.519355990f, -0.524589683f, -0.529803625f, -0.534997620f, -0.540171473f, -0.545324988f, -0.550457973f,
+  -0.555570233f, -0.560661576f, -0.565731811f, -0.570780746f, -0.575808191f, -0.580813958f, -0.585797857f, -0.590759702f,
+  -0.595699304f, -0.600616479f, -0.605511041f, -0.610382806f, -0.615231591f, -0.620057212f, -0.624859488f, -0.629638239f,
+  -0.634393284f, -0.639124445f, -0.643831543f, -0.648514401f, -0.653172843f, -0.657806693f, -0.662415778f, -0.666999922f,
+  -0.671558955f, -0.676092704f, -0.680600998f, -0.685083668f, -0.689540545f, -0.693971461f, -0.698376249f, -0.702754744f,
+  -0.707106781f, -0.711432196f, -0.715730825f, -0.720002508f, -0.724247083f, -0.728464390f, -0.732654272f, -0.736816569f,
+  -0.740951125f, -0.745057785f, -0.749136395f, -0.753186799f, -0.757208847f, -0.761202385f, -0.765167266f, -0.769103338f,
+  -0.773010453f, -0.776888466f, -0.780737229f, -0.784556597f, -0.788346428f, -0.792106577f, -0.795836905f, -0.799537269f,
+  -0.803207531f, -0.806847554f, -0.810457198f, -0.814036330f, -0.817584813f, -0.821102515f, -0.824589303f, -0.828045045f,
+  -0.831469612f, -0.834862875f, -0.838224706f, -0.841554977f, -0.844853565f, -0.848120345f, -0.851355193f, -0.854557988f,
+  -0.857728610f, -0.860866939f, -0.863972856f, -0.867046246f, -0.870086991f, -0.873094978f, -0.876070094f, -0.879012226f,
+  -0.881921264f, -0.884797098f, -0.887639620f, -0.890448723f, -0.893224301f, -0.895966250f, -0.898674466f, -0.901348847f,
+  -0.903989293f, -0.906595705f, -0.909167983f, -0.911706032f, -0.914209756f, -0.916679060f, -0.919113852f, -0.921514039f,
+  -0.923879533f, -0.926210242f, -0.928506080f, -0.930766961f, -0.932992799f, -0.935183510f, -0.937339012f, -0.939459224f,
+  -0.941544065f, -0.943593458f, -0.945607325f, -0.947585591f, -0.949528181f, -0.951435021f, -0.953306040f, -0.955141168f,
+  -0.956940336f, -0.958703475f, -0.960430519f, -0.962121404f, -0.963776066f, -0.965394442f, -0.966976471f, -0.968522094f,
+  -0.970031253f, -0.971503891f, -0.972939952f, -0.974339383f, -0.975702130f, -0.977028143f, -0.978317371f, -0.979569766f,
+  -0.980785280f, -0.981963869f, -0.983105487f, -0.984210092f, -0.985277642f, -0.986308097f, -0.987301418f, -0.988257568f,
+  -0.989176510f, -0.990058210f, -0.990902635f, -0.991709754f, -0.992479535f, -0.993211949f, -0.993906970f, -0.994564571f,
+  -0.995184727f, -0.995767414f, -0.996312612f, -0.996820299f, -0.997290457f, -0.997723067f, -0.998118113f, -0.998475581f,
+  -0.998795456f, -0.999077728f, -0.999322385f, -0.999529418f, -0.999698819f, -0.999830582f, -0.999924702f, -0.999981175f,
+};
+
+static const float fftSin[512] PROGMEM = {
+  0.000000000f, 0.006135885f, 0.012271538f, 0.018406730f, 0.024541229f, 0.030674803f, 0.036807223f, 0.042938257f,
+  0.049067674f, 0.055195244f, 0.061320736f, 0.067443920f, 0.073564564f, 0.079682438f, 0.085797312f, 0.091908956f,
+  0.098017140f, 0.104121634f, 0.110222207f, 0.116318631f, 0.122410675f, 0.128498111f, 0.134580709f, 0.140658239f,
+  0.146730474f, 0.152797185f, 0.158858143f, 0.164913120f, 0.170961889f, 0.177004220f, 0.183039888f, 0.189068664f,
+  0.195090322f, 0.201104635f, 0.207111376f, 0.213110320f, 0.219101240f, 0.225083911f, 0.231058108f, 0.237023606f,
+  0.242980180f, 0.248927606f, 0.254865660f, 0.260794118f, 0.266712757f, 0.272621355f, 0.278519689f, 0.284407537f,
+  0.290284677f, 0.296150888f, 0.302005949f, 0.307849640f, 0.313681740f, 0.319502031f, 0.325310292f, 0.331106306f,
+  0.336889853f, 0.342660717f, 0.348418680f, 0.354163525f, 0.359895037f, 0.365612998f, 0.371317194f, 0.377007410f,
+  0.382683432f, 0.388345047f, 0.393992040f, 0.399624200f, 0.405241314f, 0.410843171f, 0.416429560f, 0.422000271f,
+  0.427555093f, 0.433093819f, 0.438616239f, 0.444122145f, 0.449611330f, 0.455083587f, 0.460538711f, 0.465976496f,
+  0.471396737f, 0.476799230f, 0.482183772f, 0.487550160f, 0.492898192f, 0.498227667f, 0.503538384f, 0.508830143f,
+  0.514102744f, 0.519355990f, 0.524589683f, 0.529803625f, 0.534997620f, 0.540171473f, 0.545324988f, 0.550457973f,
+  0.555570233f, 0.560661576f, 0.565731811f, 0.570780746f, 0.575808191f, 0.580813958f, 0.585797857f, 0.590759702f,
+  0.595699304f, 0.600616479f, 0.605511041f, 0.610382806f, 0.615231591f, 0.620057212f, 0.624859488f, 0.629638239f,
+  0.634393284f, 0.639124445f, 0.643831543f, 0.648514401f, 0.653172843f, 0.657806693f, 0.662415778f, 0.666999922f,
+  0.671558955f, 0.676092704f, 0.680600998f, 0.685083668f, 0.689540545f, 0.693971461f, 0.698376249f, 0.702754744f,
+  0.707106781f, 0.711432196f, 0.715730825f, 0.720002508f, 0.724247083f, 0.728464390f, 0.732654272f, 0.736816569f,
+  0.740951125f, 0.745057785f, 0.749136395f, 0.753186799f, 0.757208847f, 0.761202385f, 0.765167266f, 0.769103338f,
+  0.773010453f, 0.776888466f, 0.780737229f, 0.784556597f, 0.788346428f, 0.792106577f, 0.795836905f, 0.799537269f,
+  0.803207531f, 0.806847554f, 0.810457198f, 0.814036330f, 0.817584813f, 0.821102515f, 0.824589303f, 0.828045045f,
+  0.831469612f, 0.834862875f, 0.838224706f, 0.841554977f, 0.844853565f, 0.848120345f, 0.851355193f, 0.854557988f,
+  0.857728610f, 0.860866939f, 0.863972856f, 0.867046246f, 0.870086991f, 0.873094978f, 0.876070094f, 0.879012226f,
+  0.881921264f, 0.884797098f, 0.887639620f, 0.890448723f, 0.893224301f, 0.895966250f, 0.898674466f, 0.901348847f,
+  0.903989293f, 0.906595705f, 0.909167983f, 0.911706032f, 0.914209756f, 0.916679060f, 0.919113852f, 0.921514039f,
+  0.923879533f, 0.926210242f, 0.928506080f, 0.930766961f, 0.932992799f, 0.935183510f, 0.937339012f, 0.939459224f,
+  0.941544065f, 0.943593458f, 0.945607325f, 0.947585591f, 0.949528181f, 0.951435021f, 0.953306040f, 0.955141168f,
+  0.956940336f, 0.958703475f, 0.960430519f, 0.962121404f, 0.963776066f, 0.965394442f, 0.966976471f, 0.968522094f,
+  0.970031253f, 0.971503891f, 0.972939952f, 0.974339383f, 0.975702130f, 0.977028143f, 0.978317371f, 0.979569766f,
+  0.980785280f, 0.981963869f, 0.983105487f, 0.984210092f, 0.985277642f, 0.986308097f, 0.987301418f, 0.988257568f,
+  0.989176510f, 0.990058210f, 0.990902635f, 0.991709754f, 0.992479535f, 0.993211949f, 0.993906970f, 0.994564571f,
+  0.995184727f, 0.995767414f, 0.996312612f, 0.996820299f, 0.997290457f, 0.997723067f, 0.998118113f, 0.998475581f,
+  0.998795456f, 0.999077728f, 0.999322385f, 0.999529418f, 0.999698819f, 0.999830582f, 0.999924702f, 0.999981175f,
+  1.000000000f, 0.999981175f, 0.999924702f, 0.999830582f, 0.999698819f, 0.999529418f, 0.999322385f, 0.999077728f,
+  0.998795456f, 0.998475581f, 0.998118113f, 0.997723067f, 0.997290457f, 0.996820299f, 0.996312612f, 0.995767414f,
+  0.995184727f, 0.994564571f, 0.993906970f, 0.993211949f, 0.992479535f, 0.991709754f, 0.990902635f, 0.990058210f,
+  0.989176510f, 0.988257568f, 0.987301418f, 0.986308097f, 0.985277642f, 0.984210092f, 0.983105487f, 0.981963869f,
+  0.980785280f, 0.979569766f, 0.978317371f, 0.977028143f, 0.975702130f, 0.974339383f, 0.972939952f, 0.971503891f,
+  0.970031253f, 0.968522094f, 0.966976471f, 0.965394442f, 0.963776066f, 0.962121404f, 0.960430519f, 0.958703475f,
+  0.956940336f, 0.955141168f, 0.953306040f, 0.951435021f, 0.949528181f, 0.947585591f, 0.945607325f, 0.943593458f,
+  0.941544065f, 0.939459224f, 0.937339012f, 0.935183510f, 0.932992799f, 0.930766961f, 0.928506080f, 0.926210242f,
+  0.923879533f, 0.921514039f, 0.919113852f, 0.916679060f, 0.914209756f, 0.911706032f, 0.909167983f, 0.906595705f,
+  0.903989293f, 0.901348847f, 0.898674466f, 0.895966250f, 0.893224301f, 0.890448723f, 0.887639620f, 0.884797098f,
+  0.881921264f, 0.879012226f, 0.876070094f, 0.873094978f, 0.870086991f, 0.867046246f, 0.863972856f, 0.860866939f,
+  0.857728610f, 0.854557988f, 0.851355193f, 0.848120345f, 0.844853565f, 0.841554977f, 0.838224706f, 0.834862875f,
+  0.831469612f, 0.828045045f, 0.824589303f, 0.821102515f, 0.817584813f, 0.814036330f, 0.810457198f, 0.806847554f,
+  0.803207531f, 0.799537269f, 0.795836905f, 0.792106577f, 0.788346428f, 0.784556597f, 0.780737229f, 0.776888466f,
+  0.773010453f, 0.769103338f, 0.765167266f, 0.761202385f, 0.757208847f, 0.753186799f, 0.749136395f, 0.745057785f,
+  0.740951125f, 0.736816569f, 0.732654272f, 0.728464390f, 0.724247083f, 0.720002508f, 0.715730825f, 0.711432196f,
+  0.707106781f, 0.702754744f, 0.698376249f, 0.693971461f, 0.689540545f, 0.685083668f, 0.680600998f, 0.676092704f,
+  0.671558955f, 0.666999922f, 0.662415778f, 0.657806693f, 0.653172843f, 0.648514401f, 0.643831543f, 0.639124445f,
+  0.634393284f, 0.629638239f, 0.624859488f, 0.620057212f, 0.615231591f, 0.610382806f, 0.605511041f, 0.600616479f,
+  0.595699304f, 0.590759702f, 0.585797857f, 0.580813958f, 0.575808191f, 0.570780746f, 0.565731811f, 0.560661576f,
+  0.555570233f, 0.550457973f, 0.545324988f, 0.540171473f, 0.534997620f, 0.529803625f, 0.524589683f, 0.519355990f,
+  0.514102744f, 0.508830143f, 0.503538384f, 0.498227667f, 0.492898192f, 0.487550160f, 0.482183772f, 0.476799230f,
+  0.471396737f, 0.465976496f, 0.460538711f, 0.455083587f, 0.449611330f, 0.444122145f, 0.438616239f, 0.433093819f,
+  0.427555093f, 0.422000271f, 0.416429560f, 0.410843171f, 0.405241314f, 0.399624200f, 0.393992040f, 0.388345047f,
+  0.382683432f, 0.377007410f, 0.371317194f, 0.365612998f, 0.359895037f, 0.354163525f, 0.348418680f, 0.342660717f,
+  0.336889853f, 0.331106306f, 0.325310292f, 0.319502031f, 0.313681740f, 0.307849640f, 0.302005949f, 0.296150888f,
+  0.290284677f, 0.284407537f, 0.278519689f, 0.272621355f, 0.266712757f, 0.260794118f, 0.254865660f, 0.248927606f,
+  0.242980180f, 0.237023606f, 0.231058108f, 0.225083911f, 0.219101240f, 0.213110320f, 0.207111376f, 0.201104635f,
+  0.195090322f, 0.189068664f, 0.183039888f, 0.177004220f, 0.170961889f, 0.164913120f, 0.158858143f, 0.152797185f,
+  0.146730474f, 0.140658239f, 0.134580709f, 0.128498111f, 0.122410675f, 0.116318631f, 0.110222207f, 0.104121634f,
+  0.098017140f, 0.091908956f, 0.085797312f, 0.079682438f, 0.073564564f, 0.067443920f, 0.061320736f, 0.055195244f,
+  0.049067674f, 0.042938257f, 0.036807223f, 0.030674803f, 0.024541229f, 0.018406730f, 0.012271538f, 0.006135885f,
+};
+
+static const float fftWindow[1024] PROGMEM = {
+  0.000000000f, 0.000009412f, 0.000037649f, 0.000084709f, 0.000150591f, 0.000235291f, 0.000338808f, 0.000461136f,
+  0.000602272f, 0.000762210f, 0.000940944f, 0.001138467f, 0.001354772f, 0.001589850f, 0.001843694f, 0.002116293f,
+  0.002407637f, 0.002717715f, 0.003046515f, 0.003394025f, 0.003760233f, 0.004145123f, 0.004548682f, 0.004970895f,
+  0.005411745f, 0.005871216f, 0.006349291f, 0.006845951f, 0.007361179f, 0.007894954f, 0.008447256f, 0.009018065f,
+  0.009607360f, 0.010215117f, 0.010841315f, 0.011485929f, 0.012148935f, 0.012830309f, 0.013530024f, 0.014248055f,
+  0.014984373f, 0.015738953f, 0.016511764f, 0.017302779f, 0.018111967f, 0.018939298f, 0.019784740f, 0.020648263f,
+  0.021529832f, 0.022429416f, 0.023346980f, 0.024282490f, 0.025235910f, 0.026207204f, 0.027196337f, 0.028203271f,
+  0.029227967f, 0.030270388f, 0.031330494f, 0.032408245f, 0.033503601f, 0.034616519f, 0.035746960f, 0.036894879f,
+  0.038060234f, 0.039242980f, 0.040443074f, 0.041660470f, 0.042895122f, 0.044146984f, 0.045416008f, 0.046702148f,
+  0.048005353f, 0.049325576f, 0.050662767f, 0.052016875f, 0.053387849f, 0.054775638f, 0.056180190f, 0.057601451f,
+  0.059039368f, 0.060493887f, 0.061964953f, 0.063452511f, 0.064956504f, 0.066476877f, 0.068013572f, 0.069566531f,
+  0.071135695f, 0.072721006f, 0.074322403f, 0.075939828f, 0.077573217f, 0.079222511f, 0.080887647f, 0.082568563f,
+  0.084265194f, 0.085977477f, 0.087705349f, 0.089448743f, 0.091207593f, 0.092981835f, 0.094771401f, 0.096576223f,
+  0.098396234f, 0.100231365f, 0.102081548f, 0.103946711f, 0.105826786f, 0.107721701f, 0.109631386f, 0.111555767f,
+  0.113494773f, 0.115448331f, 0.117416367f, 0.119398807f, 0.121395577f, 0.123406600f, 0.125431803f, 0.127471107f,
+  0.129524437f, 0.131591716f, 0.133672864f, 0.135767805f, 0.137876459f, 0.139998746f, 0.142134587f, 0.144283902f,
+  0.146446609f, 0.148622628f, 0.150811875f, 0.153014270f, 0.155229728f, 0.157458166f, 0.159699501f, 0.161953648f,
+  0.164220523f, 0.166500039f, 0.168792111f, 0.171096653f, 0.173413579f, 0.175742799f, 0.178084229f, 0.180437778f,
+  0.182803358f, 0.185180881f, 0.187570256f, 0.189971394f, 0.192384205f, 0.194808597f, 0.197244479f, 0.199691760f,
+  0.202150348f, 0.204620149f, 0.207101071f, 0.209593021f, 0.212095904f, 0.214609627f, 0.217134095f, 0.219669212f,
+  0.222214883f, 0.224771014f, 0.227337506f, 0.229914264f, 0.232501190f, 0.235098188f, 0.237705159f, 0.240322005f,
+  0.242948628f, 0.245584929f, 0.248230808f, 0.250886167f, 0.253550904f, 0.256224920f, 0.258908114f, 0.261600385f,
+  0.264301632f, 0.267011752f, 0.269730645f, 0.272458206f, 0.275194335f, 0.277938928f, 0.280691881f, 0.283453091f,
+  0.286222453f, 0.288999865f, 0.291785220f, 0.294578414f, 0.297379343f, 0.300187900f, 0.303003980f, 0.305827477f,
+  0.308658284f, 0.311496295f, 0.314341403f, 0.317193501f, 0.320052482f, 0.322918237f, 0.325790660f, 0.328669641f,
+  0.331555073f, 0.334446847f, 0.337344854f, 0.340248985f, 0.343159130f, 0.346075180f, 0.348997025f, 0.351924556f,
+  0.354857661f, 0.357796231f, 0.360740155f, 0.363689322f, 0.366643621f, 0.369602941f, 0.372567170f, 0.375536197f,
+  0.378509910f, 0.381488197f, 0.384470946f, 0.387458044f, 0.390449380f, 0.393444840f, 0.396444312f, 0.399447683f,
+  0.402454839f, 0.405465668f, 0.408480056f, 0.411497890f, 0.414519056f, 0.417543440f, 0.420570928f, 0.423601407f,
+  0.426634763f, 0.429670880f, 0.432709646f, 0.435750945f, 0.438794662f, 0.441840685f, 0.444888896f, 0.447939183f,
+  0.450991430f, 0.454045522f, 0.457101344f, 0.460158781f, 0.463217718f, 0.466278040f, 0.469339632f, 0.472402378f,
+  0.475466163f, 0.478530872f, 0.481596389f, 0.484662598f, 0.487729386f, 0.490796635f, 0.493864231f, 0.496932058f,
+  0.500000000f, 0.503067942f, 0.506135769f, 0.509203365f, 0.512270614f, 0.515337402f, 0.518403611f, 0.521469128f,
+  0.524533837f, 0.527597622f, 0.530660368f, 0.533721960f, 0.536782282f, 0.539841219f, 0.542898656f, 0.545954478f,
+  0.549008570f, 0.552060817f, 0.555111104f, 0.558159315f, 0.561205338f, 0.564249055f, 0.567290354f, 0.570329120f,
+  0.573365237f, 0.576398593f, 0.579429072f, 0.582456560f, 0.585480944f, 0.588502110f, 0.591519944f, 0.594534332f,
+  0.597545161f, 0.600552317f, 0.603555688f, 0.606555160f, 0.609550620f, 0.612541956f, 0.615529054f, 0.618511803f,
+  0.621490090f, 0.624463803f, 0.627432830f, 0.630397059f, 0.633356379f, 0.636310678f, 0.639259845f, 0.642203769f,
+  0.645142339f, 0.648075444f, 0.651002975f, 0.653924820f, 0.656840870f, 0.659751015f, 0.662655146f, 0.665553153f,
+  0.668444927f, 0.671330359f, 0.674209340f, 0.677081763f, 0.679947518f, 0.682806499f, 0.685658597f, 0.688503705f,
+  0.691341716f, 0.694172523f, 0.696996020f, 0.699812100f, 0.702620657f, 0.705421586f, 0.708214780f, 0.711000135f,
+  0.713777547f, 0.716546909f, 0.719308119f, 0.722061072f, 0.724805665f, 0.727541794f, 0.730269355f, 0.732988248f,
+  0.735698368f, 0.738399615f, 0.741091886f, 0.743775080f, 0.746449096f, 0.749113833f, 0.751769192f, 0.754415071f,
+  0.757051372f, 0.759677995f, 0.762294841f, 0.764901812f, 0.767498810f, 0.770085736f, 0.772662494f, 0.775228986f,
+  0.777785117f, 0.780330788f, 0.782865905f, 0.785390373f, 0.787904096f, 0.790406979f, 0.792898929f, 0.795379851f,
+  0.797849652f, 0.800308240f, 0.802755521f, 0.805191403f, 0.807615795f, 0.810028606f, 0.812429744f, 0.814819119f,
+  0.817196642f, 0.819562222f, 0.821915771f, 0.824257201f, 0.826586421f, 0.828903347f, 0.831207889f, 0.833499961f,
+  0.835779477f, 0.838046352f, 0.840300499f, 0.842541834f, 0.844770272f, 0.846985730f, 0.849188125f, 0.851377372f,
+  0.853553391f, 0.855716098f, 0.857865413f, 0.860001254f, 0.862123541f, 0.864232195f, 0.866327136f, 0.868408284f,
+  0.870475563f, 0.872528893f, 0.874568197f, 0.876593400f, 0.878604423f, 0.880601193f, 0.882583633f, 0.884551669f,
+  0.886505227f, 0.888444233f, 0.890368614f, 0.892278299f, 0.894173214f, 0.896053289f, 0.897918452f, 0.899768635f,
+  0.901603766f, 0.903423777f, 0.905228599f, 0.907018165f, 0.908792407f, 0.910551257f, 0.912294651f, 0.914022523f,
+  0.915734806f, 0.917431437f, 0.919112353f, 0.920777489f, 0.922426783f, 0.924060172f, 0.925677597f, 0.927278994f,
+  0.928864305f, 0.930433469f, 0.931986428f, 0.933523123f, 0.935043496f, 0.936547489f, 0.938035047f, 0.939506113f,
+  0.940960632f, 0.942398549f, 0.943819810f, 0.945224362f, 0.946612151f, 0.947983125f, 0.949337233f, 0.950674424f,
+  0.951994647f, 0.953297852f, 0.954583992f, 0.955853016f, 0.957104878f, 0.958339530f, 0.959556926f, 0.960757020f,
+  0.961939766f, 0.963105121f, 0.964253040f, 0.965383481f, 0.966496399f, 0.967591755f, 0.968669506f, 0.969729612f,
+  0.970772033f, 0.971796729f, 0.972803663f, 0.973792796f, 0.974764090f, 0.975717510f, 0.976653020f, 0.977570584f,
+  0.978470168f, 0.979351737f, 0.980215260f, 0.981060702f, 0.981888033f, 0.982697221f, 0.983488236f, 0.984261047f,
+  0.985015627f, 0.985751945f, 0.986469976f, 0.987169691f, 0.987851065f, 0.988514071f, 0.989158685f, 0.989784883f,
+  0.990392640f, 0.990981935f, 0.991552744f, 0.992105046f, 0.992638821f, 0.993154049f, 0.993650709f, 0.994128784f,
+  0.994588255f, 0.995029105f, 0.995451318f, 0.995854877f, 0.996239767f, 0.996605975f, 0.996953485f, 0.997282285f,
+  0.997592363f, 0.997883707f, 0.998156306f, 0.998410150f, 0.998645228f, 0.998861533f, 0.999059056f, 0.999237790f,
+  0.999397728f, 0.999538864f, 0.999661192f, 0.999764709f, 0.999849409f, 0.999915291f, 0.999962351f, 0.999990588f,
+  1.000000000f, 0.999990588f, 0.999962351f, 0.999915291f, 0.999849409f, 0.999764709f, 0.999661192f, 0.999538864f,
+  0.999397728f, 0.999237790f, 0.999059056f, 0.998861533f, 0.998645228f, 0.998410150f, 0.998156306f, 0.997883707f,
+  0.997592363f, 0.997282285f, 0.996953485f, 0.996605975f, 0.996239767f, 0.995854877f, 0.995451318f, 0.995029105f,
+  0.994588255f, 0.994128784f, 0.993650709f, 0.993154049f, 0.992638821f, 0.992105046f, 0.991552744f, 0.990981935f,
+  0.990392640f, 0.989784883f, 0.989158685f, 0.988514071f, 0.987851065f, 0.987169691f, 0.986469976f, 0.985751945f,
+  0.985015627f, 0.984261047f, 0.983488236f, 0.982697221f, 0.981888033f, 0.981060702f, 0.980215260f, 0.979351737f,
+  0.978470168f, 0.977570584f, 0.976653020f, 0.975717510f, 0.974764090f, 0.973792796f, 0.972803663f, 0.971796729f,
+  0.970772033f, 0.969729612f, 0.968669506f, 0.967591755f, 0.966496399f, 0.965383481f, 0.964253040f, 0.963105121f,
+  0.961939766f, 0.960757020f, 0.959556926f, 0.958339530f, 0.957104878f, 0.955853016f, 0.954583992f, 0.953297852f,
+  0.951994647f, 0.950674424f, 0.949337233f, 0.947983125f, 0.946612151f, 0.945224362f, 0.943819810f, 0.942398549f,
+  0.940960632f, 0.939506113f, 0.938035047f, 0.936547489f, 0.935043496f, 0.933523123f, 0.931986428f, 0.930433469f,
+  0.928864305f, 0.927278994f, 0.925677597f, 0.924060172f, 0.922426783f, 0.920777489f, 0.919112353f, 0.917431437f,
+  0.915734806f, 0.914022523f, 0.912294651f, 0.910551257f, 0.908792407f, 0.907018165f, 0.905228599f, 0.903423777f,
+  0.901603766f, 0.899768635f, 0.897918452f, 0.896053289f, 0.894173214f, 0.892278299f, 0.890368614f, 0.888444233f,
+  0.886505227f, 0.884551669f, 0.882583633f, 0.880601193f, 0.878604423f, 0.876593400f, 0.874568197f, 0.872528893f,
+  0.870475563f, 0.868408284f, 0.866327136f, 0.864232195f, 0.862123541f, 0.860001254f, 0.857865413f, 0.855716098f,
+  0.853553391f, 0.851377372f, 0.849188125f, 0.846985730f, 0.844770272f, 0.842541834f, 0.840300499f, 0.838046352f,
+  0.835779477f, 0.833499961f, 0.831207889f, 0.828903347f, 0.826586421f, 0.824257201f, 0.821915771f, 0.819562222f,
+  0.817196642f, 0.814819119f, 0.812429744f, 0.810028606f, 0.807615795f, 0.805191403f, 0.802755521f, 0.800308240f,
+  0.797849652f, 0.795379851f, 0.792898929f, 0.790406979f, 0.787904096f, 0.785390373f, 0.782865905f, 0.780330788f,
+  0.777785117f, 0.775228986f, 0.772662494f, 0.770085736f, 0.767498810f, 0.764901812f, 0.762294841f, 0.759677995f,
+  0.757051372f, 0.754415071f, 0.751769192f, 0.749113833f, 0.746449096f, 0.743775080f, 0.741091886f, 0.738399615f,
+  0.735698368f, 0.732988248f, 0.730269355f, 0.727541794f, 0.724805665f, 0.722061072f, 0.719308119f, 0.716546909f,
+  0.713777547f, 0.711000135f, 0.708214780f, 0.705421586f, 0.702620657f, 0.699812100f, 0.696996020f, 0.694172523f,
+  0.691341716f, 0.688503705f, 0.685658597f, 0.682806499f, 0.679947518f, 0.677081763f, 0.674209340f, 0.671330359f,
+  0.668444927f, 0.665553153f, 0.662655146f, 0.659751015f, 0.656840870f, 0.653924820f, 0.651002975f, 0.648075444f,
+  0.645142339f, 0.642203769f, 0.639259845f, 0.636310678f, 0.633356379f, 0.630397059f, 0.627432830f, 0.624463803f,
+  0.621490090f, 0.618511803f, 0.615529054f, 0.612541956f, 0.609550620f, 0.606555160f, 0.603555688f, 0.600552317f,
+  0.597545161f, 0.594534332f, 0.591519944f, 0.588502110f, 0.585480944f, 0.582456560f, 0.579429072f, 0.576398593f,
+  0.573365237f, 0.570329120f, 0.567290354f, 0.564249055f, 0.561205338f, 0.558159315f, 0.555111104f, 0.552060817f,
+  0.549008570f, 0.545954478f, 0.542898656f, 0.539841219f, 0.536782282f, 0.533721960f, 0.530660368f, 0.527597622f,
+  0.524533837f, 0.521469128f, 0.518403611f, 0.515337402f, 0.512270614f, 0.509203365f, 0.506135769f, 0.503067942f,
+  0.500000000f, 0.496932058f, 0.493864231f, 0.490796635f, 0.487729386f, 0.484662598f, 0.481596389f, 0.478530872f,
+  0.475466163f, 0.472402378f, 0.469339632f, 0.466278040f, 0.463217718f, 0.460158781f, 0.457101344f, 0.454045522f,
+  0.450991430f, 0.447939183f, 0.444888896f, 0.441840685f, 0.438794662f, 0.435750945f, 0.432709646f, 0.429670880f,
+  0.426634763f, 0.423601407f, 0.420570928f, 0.417543440f, 0.414519056f, 0.411497890f, 0.408480056f, 0.405465668f,
+  0.402454839f, 0.399447683f, 0.396444312f, 0.393444840f, 0.390449380f, 0.387458044f, 0.384470946f, 0.381488197f,
+  0.378509910f, 0.375536197f, 0.372567170f, 0.369602941f, 0.366643621f, 0.363689322f, 0.360740155f, 0.357796231f,
+  0.354857661f, 0.351924556f, 0.348997025f, 0.346075180f, 0.343159130f, 0.340248985f, 0.337344854f, 0.334446847f,
+  0.331555073f, 0.328669641f, 0.325790660f, 0.322918237f, 0.320052482f, 0.317193501f, 0.314341403f, 0.311496295f,
+  0.308658284f, 0.305827477f, 0.303003980f, 0.300187900f, 0.297379343f, 0.294578414f, 0.291785220f, 0.288999865f,
+  0.286222453f, 0.283453091f, 0.280691881f, 0.277938928f, 0.275194335f, 0.272458206f, 0.269730645f, 0.267011752f,
+  0.264301632f, 0.261600385f, 0.258908114f, 0.256224920f, 0.253550904f, 0.250886167f, 0.248230808f, 0.245584929f,
+  0.242948628f, 0.240322005f, 0.237705159f, 0.235098188f, 0.232501190f, 0.229914264f, 0.227337506f, 0.224771014f,
+  0.222214883f, 0.219669212f, 0.217134095f, 0.214609627f, 0.212095904f, 0.209593021f, 0.207101071f, 0.204620149f,
+  0.202150348f, 0.199691760f, 0.197244479f, 0.194808597f, 0.192384205f, 0.189971394f, 0.187570256f, 0.185180881f,
+  0.182803358f, 0.180437778f, 0.178084229f, 0.175742799f, 0.173413579f, 0.171096653f, 0.168792111f, 0.166500039f,
+  0.164220523f, 0.161953648f, 0.159699501f, 0.157458166f, 0.155229728f, 0.153014270f, 0.150811875f, 0.148622628f,
+  0.146446609f, 0.144283902f, 0.142134587f, 0.139998746f, 0.137876459f, 0.135767805f, 0.133672864f, 0.131591716f,
+  0.129524437f, 0.127471107f, 0.125431803f, 0.123406600f, 0.121395577f, 0.119398807f, 0.117416367f, 0.115448331f,
+  0.113494773f, 0.111555767f, 0.109631386f, 0.107721701f, 0.105826786f, 0.103946711f, 0.102081548f, 0.100231365f,
+  0.098396234f, 0.096576223f, 0.094771401f, 0.092981835f, 0.091207593f, 0.089448743f, 0.087705349f, 0.085977477f,
+  0.084265194f, 0.082568563f, 0.080887647f, 0.079222511f, 0.077573217f, 0.075939828f, 0.074322403f, 0.072721006f,
+  0.071135695f, 0.069566531f, 0.068013572f, 0.066476877f, 0.064956504f, 0.063452511f, 0.061964953f, 0.060493887f,
+  0.059039368f, 0.057601451f, 0.056180190f, 0.054775638f, 0.053387849f, 0.052016875f, 0.050662767f, 0.049325576f,
+  0.048005353f, 0.046702148f, 0.045416008f, 0.044146984f, 0.042895122f, 0.041660470f, 0.040443074f, 0.039242980f,
+  0.038060234f, 0.036894879f, 0.035746960f, 0.034616519f, 0.033503601f, 0.032408245f, 0.031330494f, 0.030270388f,
+  0.029227967f, 0.028203271f, 0.027196337f, 0.026207204f, 0.025235910f, 0.024282490f, 0.023346980f, 0.022429416f,
+  0.021529832f, 0.020648263f, 0.019784740f, 0.018939298f, 0.018111967f, 0.017302779f, 0.016511764f, 0.015738953f,
+  0.014984373f, 0.014248055f, 0.013530024f, 0.012830309f, 0.012148935f, 0.011485929f, 0.010841315f, 0.010215117f,
+  0.009607360f, 0.009018065f, 0.008447256f, 0.007894954f, 0.007361179f, 0.006845951f, 0.006349291f, 0.005871216f,
+  0.005411745f, 0.004970895f, 0.004548682f, 0.004145123f, 0.003760233f, 0.003394025f, 0.003046515f, 0.002717715f,
+  0.002407637f, 0.002116293f, 0.001843694f, 0.001589850f, 0.001354772f, 0.001138467f, 0.000940944f, 0.000762210f,
+  0.000602272f, 0.000461136f, 0.000338808f, 0.000235291f, 0.000150591f, 0.000084709f, 0.000037649f, 0.000009412f,
+};
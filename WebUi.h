@@ -0,0 +1,145 @@
+// Generated by tools/make_webui.py from web/index.html - do not edit
+// Web interface: gzipped html (2206 bytes, 5554 bytes uncompressed)
+
+#define WEB_UI_ETAG "\"aa4c8d0e4e56\""
+const size_t webUiSize = 2206;
+static const uint8_t webUi[] PROGMEM = {
+  0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xa5, 0x18, 0x6b, 0x6f, 0xdb, 0x38,
+  0xf2, 0xbb, 0x7f, 0xc5, 0xd4, 0xc1, 0x9e, 0xa4, 0x8b, 0x2d, 0x3f, 0xb2, 0xe9, 0xb5, 0x7e, 0x2d,
+  0x9a, 0x6e, 0x8b, 0xee, 0xa1, 0xd9, 0x0d, 0xb6, 0xe9, 0x1d, 0x0e, 0x41, 0xb0, 0xa0, 0x25, 0xca,
+  0x66, 0xad, 0x17, 0x44, 0xca, 0xb1, 0x9b, 0xf5, 0x7f, 0xbf, 0x19, 0x92, 0x92, 0xe5, 0xc7, 0x61,
+  0x8b, 0x9e, 0x3e, 0x48, 0xe4, 0x70, 0xde, 0x9c, 0x19, 0x0e, 0x35, 0x79, 0xf1, 0xf3, 0x6f, 0x6f,
+  0xef, 0xff, 0x73, 0xf7, 0x0e, 0x96, 0x2a, 0x89, 0x67, 0xad, 0x49, 0xf5, 0xe1, 0x2c, 0xc4, 0x4f,
+  0xc2, 0x15, 0x83, 0x94, 0x25, 0x7c, 0xda, 0x5e, 0x0b, 0xfe, 0x94, 0x67, 0x85, 0x6a, 0x43, 0x90,
+  0xa5, 0x8a, 0xa7, 0x6a, 0xda, 0x7e, 0x12, 0xa1, 0x5a, 0x4e, 0x43, 0xbe, 0x16, 0x01, 0xef, 0xea,
+  0x49, 0x07, 0x44, 0x2a, 0x94, 0x60, 0x71, 0x57, 0x06, 0x2c, 0xe6, 0xd3, 0x41, 0x1b, 0x99, 0x28,
+  0xa1, 0x62, 0x3e, 0x7b, 0x9b, 0x25, 0x79, 0xc1, 0xa5, 0xcc, 0x8a, 0x49, 0xcf, 0x40, 0x5a, 0x13,
+  0xa9, 0xb6, 0xf4, 0x9d, 0x67, 0xe1, 0x16, 0x9e, 0xe7, 0x2c, 0x58, 0x2d, 0x8a, 0xac, 0x4c, 0xc3,
+  0x6e, 0x90, 0xc5, 0x59, 0x31, 0x82, 0x8b, 0x40, 0x3f, 0x63, 0x88, 0x50, 0x62, 0x37, 0x62, 0x89,
+  0x88, 0xb7, 0x23, 0x78, 0x53, 0x20, 0xff, 0x31, 0x28, 0xbe, 0x51, 0x5d, 0x16, 0x8b, 0x45, 0x3a,
+  0x82, 0x98, 0x47, 0x6a, 0x0c, 0x09, 0x2b, 0x16, 0x02, 0x67, 0xfd, 0x7c, 0x03, 0xac, 0x54, 0xd9,
+  0x18, 0x72, 0x16, 0x86, 0x22, 0x5d, 0x74, 0x55, 0x96, 0x8f, 0x60, 0x88, 0xf0, 0x3d, 0x88, 0x48,
+  0x46, 0x70, 0x45, 0xb0, 0x5d, 0xcb, 0x97, 0xb1, 0x08, 0x79, 0x01, 0xcf, 0xda, 0x88, 0x11, 0xbc,
+  0xbe, 0xfe, 0x01, 0xa1, 0x17, 0x68, 0x3d, 0x2f, 0x64, 0x07, 0x2e, 0x62, 0x86, 0x06, 0x07, 0x5b,
+  0x1a, 0xf1, 0x05, 0x4f, 0x43, 0x78, 0xd6, 0x1a, 0x49, 0xf1, 0x95, 0x8f, 0x40, 0x26, 0x2c, 0x8e,
+  0x09, 0x5d, 0xe6, 0x3c, 0x50, 0x45, 0x99, 0x1c, 0xb0, 0x81, 0x25, 0x17, 0x8b, 0xa5, 0x22, 0xf1,
+  0x5a, 0xfe, 0x19, 0x2b, 0x87, 0xfa, 0x41, 0x0e, 0x93, 0x9e, 0x75, 0xc8, 0xa4, 0x67, 0xfd, 0x4f,
+  0x9e, 0xa1, 0xdd, 0x18, 0x1e, 0xb8, 0x0f, 0xa7, 0xad, 0x49, 0x28, 0xd6, 0x20, 0xc2, 0xa9, 0x63,
+  0x54, 0x97, 0xce, 0x6c, 0xd2, 0x43, 0x90, 0x59, 0x98, 0x4d, 0xe6, 0xc5, 0xec, 0x0e, 0xd1, 0xb9,
+  0x92, 0xf0, 0xb7, 0x74, 0x2e, 0xf3, 0xf1, 0x44, 0xe6, 0x2c, 0xd5, 0x04, 0xb9, 0x81, 0x13, 0x01,
+  0xc1, 0x66, 0x66, 0xdd, 0x62, 0xcd, 0x4b, 0xa5, 0xb2, 0x14, 0xb2, 0x34, 0x88, 0x45, 0xb0, 0x42,
+  0xe4, 0x52, 0xb9, 0xcf, 0x92, 0xad, 0xf9, 0x68, 0xb0, 0xf3, 0x9c, 0xd9, 0x27, 0x1c, 0x4d, 0x7a,
+  0x06, 0xa9, 0x16, 0x98, 0x6b, 0xb6, 0xc6, 0x59, 0xc4, 0x35, 0xaf, 0x61, 0xd6, 0x6f, 0x15, 0x30,
+  0x60, 0xe9, 0x9a, 0x49, 0xa3, 0xb5, 0xf5, 0x15, 0x2d, 0x19, 0x70, 0xc3, 0x24, 0xe3, 0x64, 0x94,
+  0x56, 0x39, 0xd4, 0x28, 0xaf, 0x9d, 0x33, 0x75, 0x8c, 0xdb, 0x2e, 0x5e, 0xe9, 0xc7, 0x99, 0x89,
+  0x14, 0x75, 0xb4, 0xa6, 0x40, 0xef, 0x2c, 0xea, 0xd5, 0x15, 0x63, 0x51, 0xe4, 0xcc, 0xb2, 0x52,
+  0xed, 0x71, 0x3b, 0xb8, 0x23, 0xf0, 0xe1, 0x2b, 0x74, 0xe9, 0xbb, 0xfa, 0xf0, 0xb5, 0x03, 0x7d,
+  0x50, 0x19, 0x74, 0x5f, 0xf7, 0x21, 0xbc, 0xa9, 0x4c, 0x93, 0x41, 0x21, 0x72, 0x35, 0x6b, 0xf5,
+  0x7a, 0x3a, 0x0b, 0x3a, 0x10, 0xb3, 0x39, 0x8f, 0x3b, 0x90, 0x88, 0x14, 0x5f, 0x6c, 0xd3, 0x41,
+  0x49, 0x3c, 0x6f, 0xad, 0x59, 0x81, 0x81, 0x55, 0xb0, 0x44, 0xc2, 0x14, 0x1e, 0x5a, 0x00, 0x0f,
+  0x4e, 0xc1, 0x94, 0xc8, 0x9c, 0x0e, 0x38, 0xbf, 0xd3, 0x00, 0x06, 0x5a, 0x4e, 0x1f, 0x01, 0x03,
+  0x12, 0x8c, 0xaf, 0x41, 0xff, 0xb1, 0xa3, 0x31, 0xd5, 0x12, 0x37, 0x64, 0x49, 0xa8, 0xf7, 0x7a,
+  0x94, 0xc5, 0x21, 0x5c, 0x23, 0xfa, 0x40, 0xa3, 0x5f, 0x13, 0x66, 0x1f, 0x5f, 0x16, 0x3b, 0x11,
+  0x1b, 0x42, 0xbd, 0x15, 0x1b, 0xd4, 0x57, 0x23, 0xfd, 0x00, 0x6e, 0x58, 0x6c, 0x71, 0x1c, 0xd8,
+  0x10, 0xe1, 0xa1, 0x87, 0x28, 0x7d, 0x4b, 0x78, 0x6d, 0x09, 0x99, 0x52, 0x18, 0x7a, 0x44, 0xfb,
+  0x46, 0x8f, 0x2a, 0x19, 0x89, 0x6c, 0x48, 0xa9, 0x90, 0x0b, 0x1e, 0x73, 0x26, 0xb9, 0xd6, 0xdf,
+  0x0c, 0x71, 0xdd, 0xe0, 0x1b, 0x82, 0x81, 0x66, 0x4f, 0xef, 0x61, 0x65, 0x07, 0xa5, 0xdc, 0xad,
+  0x48, 0xb5, 0x04, 0x1c, 0x82, 0xaa, 0xad, 0x41, 0x6f, 0x69, 0x07, 0x0c, 0x2a, 0x07, 0x1c, 0x58,
+  0xa4, 0xe9, 0xd8, 0xe6, 0x1c, 0x1d, 0xdb, 0x9c, 0xa5, 0x6b, 0x3d, 0x8e, 0xb5, 0xcb, 0xb1, 0x38,
+  0x2d, 0xd0, 0xe1, 0x8e, 0x63, 0xa6, 0x12, 0x83, 0x06, 0x53, 0x1b, 0x21, 0xcf, 0xbb, 0x71, 0xab,
+  0x15, 0x95, 0x69, 0x80, 0xae, 0x4f, 0x81, 0xc7, 0xae, 0x08, 0x3d, 0x78, 0x86, 0x82, 0xab, 0xb2,
+  0x48, 0x21, 0xcc, 0x82, 0x32, 0xc1, 0x02, 0xe6, 0x2f, 0xb8, 0x7a, 0x17, 0x73, 0x1a, 0xde, 0x6c,
+  0x7f, 0x09, 0x09, 0x69, 0x0c, 0xbb, 0x06, 0xe1, 0xbc, 0x14, 0x71, 0xe8, 0x22, 0x25, 0xea, 0x49,
+  0x02, 0xa8, 0x36, 0x5a, 0x79, 0x60, 0xf7, 0xdb, 0x8f, 0xb2, 0xe2, 0x1d, 0x0b, 0x96, 0x6e, 0x4d,
+  0xe4, 0xe6, 0x86, 0x00, 0x0c, 0xfa, 0xe5, 0x14, 0xda, 0x75, 0x4a, 0xb6, 0xe1, 0x12, 0xf2, 0x87,
+  0xc1, 0x23, 0x7e, 0xda, 0x70, 0x98, 0x77, 0x3a, 0xf0, 0xd7, 0x7f, 0x18, 0x8c, 0xbe, 0xc6, 0xa0,
+  0xdc, 0x98, 0x57, 0x74, 0x9a, 0x23, 0x20, 0x2f, 0x1d, 0xef, 0xa0, 0xb6, 0x39, 0xc6, 0x77, 0xc1,
+  0xd2, 0x05, 0x77, 0x20, 0x88, 0x99, 0x94, 0x55, 0x25, 0x70, 0x34, 0xa7, 0x03, 0x3e, 0xb4, 0x01,
+  0x15, 0x68, 0x58, 0x81, 0xd8, 0xa6, 0x02, 0x5d, 0x59, 0x10, 0x85, 0x72, 0x05, 0xfb, 0xb1, 0xd6,
+  0x80, 0x74, 0x6f, 0x93, 0xc1, 0x3b, 0x8f, 0xde, 0xe8, 0xcc, 0xba, 0xe4, 0x78, 0xbe, 0x48, 0x53,
+  0x5e, 0x7c, 0xb8, 0xbf, 0xfd, 0x88, 0x6e, 0x21, 0x73, 0xbf, 0xcd, 0x31, 0xc8, 0x83, 0x74, 0xf3,
+  0xfc, 0x2c, 0x35, 0xd6, 0x4c, 0x61, 0x8f, 0x55, 0x21, 0x19, 0x51, 0xeb, 0x3f, 0x1c, 0x6b, 0x89,
+  0xe7, 0x53, 0xc5, 0x7f, 0x6b, 0xce, 0x1e, 0xa4, 0x50, 0x4b, 0x21, 0xfd, 0x35, 0x8b, 0x4b, 0x3e,
+  0xb6, 0xf8, 0xb4, 0x45, 0x89, 0xb4, 0xfb, 0x4f, 0xa3, 0x07, 0xa2, 0x7b, 0xc4, 0xf9, 0xe5, 0x29,
+  0x32, 0x05, 0x8b, 0xd6, 0xa2, 0x43, 0x98, 0x9e, 0x01, 0xef, 0x2a, 0x3b, 0x31, 0x0a, 0x30, 0xe5,
+  0xb3, 0x34, 0xde, 0xe2, 0x8b, 0x43, 0x82, 0x59, 0xc5, 0x16, 0x1c, 0x72, 0x6e, 0xf3, 0x9c, 0x6a,
+  0x1d, 0x1e, 0x75, 0x10, 0xc5, 0x54, 0xdc, 0x3b, 0xa8, 0x0c, 0x07, 0x2a, 0x76, 0x52, 0x81, 0x96,
+  0x02, 0x4f, 0x22, 0x95, 0xfb, 0x40, 0xd2, 0xc2, 0x4c, 0x01, 0x21, 0x61, 0xda, 0x42, 0x11, 0x81,
+  0x6b, 0x23, 0xf6, 0x81, 0x96, 0x1e, 0x29, 0x42, 0x0f, 0x00, 0xa8, 0x38, 0x62, 0x8f, 0x6d, 0xd8,
+  0x52, 0x68, 0xc2, 0x09, 0x02, 0x96, 0x47, 0x6d, 0x12, 0xd5, 0x69, 0x62, 0xed, 0xa3, 0x26, 0xa9,
+  0x7b, 0xea, 0x4d, 0xf2, 0x4d, 0x8a, 0xfe, 0x43, 0x92, 0x03, 0x16, 0xc6, 0xee, 0x63, 0xae, 0x11,
+  0x8b, 0xa5, 0xf5, 0x14, 0xa9, 0xa9, 0x09, 0x5f, 0x4c, 0x8d, 0x34, 0xaf, 0x69, 0x0d, 0xad, 0x78,
+  0x0d, 0xa7, 0xd5, 0x82, 0x2b, 0x7d, 0xb4, 0x78, 0x9b, 0x77, 0x11, 0x57, 0x18, 0x0f, 0x4e, 0x8f,
+  0xe5, 0xa2, 0x67, 0x82, 0x04, 0xb3, 0xfa, 0x19, 0x7d, 0xb9, 0xcc, 0xc2, 0x11, 0x38, 0x77, 0x9f,
+  0xef, 0x71, 0x4e, 0x27, 0xde, 0x08, 0xfe, 0xf9, 0xe9, 0xb7, 0x5f, 0x7d, 0xa9, 0x0a, 0x54, 0x4a,
+  0x44, 0x5b, 0xcd, 0x69, 0xe7, 0x69, 0x7d, 0x8e, 0x0d, 0x2c, 0x1a, 0x89, 0x5d, 0xf8, 0x5f, 0x64,
+  0x96, 0xba, 0x94, 0xc5, 0xd6, 0x11, 0x58, 0x47, 0x9e, 0x3c, 0x3f, 0x60, 0xea, 0x20, 0x10, 0x91,
+  0xe4, 0x58, 0x5f, 0x42, 0x74, 0xd7, 0x46, 0xdd, 0xbf, 0x0e, 0x60, 0x72, 0xca, 0x8b, 0xca, 0x69,
+  0x3a, 0xc8, 0x48, 0x8b, 0x3a, 0xac, 0x4d, 0x08, 0x4c, 0x61, 0x6d, 0xd6, 0xc6, 0x7f, 0x11, 0xc9,
+  0x35, 0xda, 0xae, 0xce, 0xb2, 0x93, 0x6a, 0xb3, 0xf6, 0xed, 0xb1, 0x7d, 0x46, 0x2d, 0xb3, 0x15,
+  0x5f, 0x4e, 0xcb, 0xce, 0xd9, 0xc3, 0xdc, 0xf0, 0x19, 0x51, 0x9a, 0x7f, 0xa1, 0x1c, 0xc7, 0x63,
+  0x9d, 0xc6, 0xee, 0x17, 0xc0, 0x0d, 0xae, 0xc4, 0xc0, 0x4f, 0x58, 0xa0, 0xec, 0x21, 0xaa, 0x5b,
+  0x9d, 0x27, 0xd3, 0xc5, 0xcc, 0xb1, 0x2c, 0x23, 0xfa, 0x08, 0xda, 0x6d, 0x8f, 0x88, 0x75, 0x45,
+  0x23, 0xf9, 0x34, 0xa9, 0x1b, 0x03, 0x38, 0xaa, 0x17, 0x55, 0xc7, 0x71, 0xbe, 0x5e, 0xd8, 0x2a,
+  0xbe, 0xf6, 0xd7, 0x58, 0x53, 0xd0, 0xa0, 0x2a, 0xfb, 0xe2, 0x0c, 0x6b, 0x79, 0x9e, 0xc5, 0xf1,
+  0x48, 0xa7, 0x97, 0xe4, 0x05, 0x22, 0x00, 0x4b, 0xe5, 0x13, 0xe2, 0xc1, 0x13, 0x6e, 0xaf, 0x86,
+  0x6b, 0x67, 0x4b, 0x08, 0x96, 0x54, 0x0b, 0x1b, 0x01, 0x88, 0x84, 0x36, 0xfa, 0xcf, 0xc7, 0x1d,
+  0x75, 0x58, 0xc8, 0x68, 0x04, 0xcf, 0xce, 0x2f, 0x51, 0xf7, 0x57, 0x4c, 0xf3, 0xee, 0x2d, 0xc5,
+  0x89, 0x83, 0xa1, 0xd8, 0xa6, 0xad, 0xd2, 0x7a, 0x5d, 0xd2, 0x64, 0xd7, 0x81, 0x00, 0x5d, 0x8e,
+  0xbd, 0x9e, 0x93, 0x66, 0x5d, 0xa9, 0xb2, 0x82, 0x3b, 0xdf, 0x14, 0x8e, 0x52, 0x31, 0x55, 0x4a,
+  0x72, 0x2c, 0x9e, 0xfd, 0xe8, 0xd3, 0x2a, 0x40, 0x1b, 0xc1, 0x89, 0xbe, 0x4c, 0x4b, 0xec, 0x1f,
+  0xa1, 0x62, 0x78, 0x36, 0x58, 0xcf, 0xa4, 0x35, 0x3a, 0x44, 0xdd, 0x8b, 0x84, 0x63, 0x53, 0xe3,
+  0x92, 0xb1, 0xfa, 0x74, 0xd4, 0xa1, 0x7f, 0x18, 0xd9, 0x5a, 0x62, 0x59, 0xc4, 0x67, 0x52, 0x11,
+  0xa1, 0xe8, 0x88, 0x33, 0xa6, 0x7d, 0x6b, 0x92, 0x1d, 0x4a, 0x32, 0x1d, 0xa0, 0x75, 0xba, 0x46,
+  0x32, 0x3e, 0xb7, 0x9d, 0xe1, 0x09, 0xd7, 0xa4, 0x71, 0x1e, 0x38, 0x7b, 0xa4, 0x83, 0xdc, 0x70,
+  0x3e, 0x66, 0x65, 0x98, 0x62, 0xf9, 0x05, 0xda, 0x92, 0xc4, 0x4f, 0x32, 0x3a, 0xae, 0x59, 0xb1,
+  0xf5, 0x55, 0xf6, 0x5e, 0x6c, 0x78, 0xe8, 0x0e, 0x28, 0x10, 0x1d, 0xec, 0xfc, 0x0c, 0x02, 0x3a,
+  0xb5, 0x50, 0xf7, 0xbc, 0x48, 0x0e, 0x10, 0x6c, 0xd1, 0x77, 0xe0, 0xe3, 0xe7, 0xf7, 0x9f, 0xe8,
+  0x92, 0xa2, 0xf8, 0x02, 0x3b, 0x34, 0x1e, 0x5a, 0xaa, 0x3d, 0xe0, 0x98, 0xaf, 0x21, 0xa0, 0xc2,
+  0xd7, 0xcd, 0x39, 0x5b, 0x59, 0x7c, 0x9a, 0xdf, 0xe1, 0xf4, 0xbc, 0x90, 0xf0, 0xe6, 0xfe, 0x8e,
+  0xda, 0xc3, 0x15, 0x2f, 0xf3, 0x4a, 0x6f, 0x3d, 0x39, 0x66, 0x1e, 0xde, 0x50, 0x47, 0x89, 0x87,
+  0x86, 0x89, 0x5e, 0x60, 0x79, 0x1e, 0x0b, 0x54, 0x0a, 0x4f, 0x16, 0x43, 0x46, 0x80, 0xad, 0x46,
+  0x2d, 0xa5, 0x63, 0x0a, 0xb2, 0xdd, 0x86, 0x86, 0x7f, 0xab, 0x2e, 0xdb, 0x16, 0xe2, 0x63, 0x37,
+  0xc7, 0x4d, 0x37, 0xd7, 0xb8, 0x27, 0x7e, 0x36, 0x0b, 0x5a, 0xae, 0x1b, 0xfb, 0x78, 0x92, 0x89,
+  0x44, 0x3b, 0xe8, 0x27, 0x70, 0xd8, 0x1c, 0x83, 0x0c, 0x57, 0x30, 0x48, 0x1c, 0x52, 0x3c, 0xf6,
+  0x2d, 0x9b, 0x5b, 0x79, 0x6c, 0x11, 0x76, 0xc0, 0xae, 0xa3, 0x51, 0xe6, 0x65, 0x14, 0xf1, 0xe2,
+  0x2d, 0xde, 0x74, 0x94, 0x5e, 0xd9, 0x10, 0x6b, 0xeb, 0xa2, 0x6a, 0xf5, 0x3d, 0x1d, 0xa5, 0x52,
+  0x2f, 0x47, 0x7a, 0xe8, 0xe1, 0x01, 0x10, 0x67, 0xd8, 0x9c, 0x9a, 0xbb, 0x1c, 0x18, 0x56, 0xd8,
+  0xbe, 0xdc, 0xea, 0xf9, 0x67, 0x69, 0x7d, 0xd1, 0x01, 0xbc, 0x40, 0xf1, 0xa2, 0x28, 0x53, 0x69,
+  0x71, 0xea, 0xb9, 0x75, 0xc2, 0xf7, 0xa4, 0x51, 0x75, 0xdf, 0xa3, 0x2e, 0x77, 0x1f, 0xdf, 0x58,
+  0x8a, 0xe6, 0x22, 0xc5, 0x90, 0x33, 0x3a, 0x42, 0x16, 0x81, 0x76, 0x7b, 0x75, 0x85, 0x19, 0x81,
+  0x29, 0x25, 0xe0, 0x0e, 0x5e, 0xc2, 0x7c, 0xab, 0x8c, 0x15, 0x78, 0xfe, 0xe3, 0xb5, 0x74, 0xcd,
+  0x63, 0x49, 0x04, 0x54, 0xa8, 0x4c, 0xab, 0xc3, 0xf0, 0xf6, 0x68, 0x01, 0xe6, 0x3a, 0xd2, 0x38,
+  0x83, 0x2c, 0x43, 0x77, 0xdf, 0x20, 0xd4, 0xad, 0xea, 0x52, 0x84, 0x21, 0x4f, 0x8f, 0xf4, 0xad,
+  0x08, 0x6a, 0x8d, 0x9b, 0x9d, 0x42, 0xb3, 0xea, 0xd5, 0xb7, 0xad, 0xef, 0x49, 0xf7, 0x6c, 0xa5,
+  0x2b, 0x17, 0x2b, 0x0a, 0xb6, 0xbd, 0xd1, 0xdb, 0xe6, 0x9e, 0x56, 0xad, 0x23, 0x0e, 0xb8, 0xbd,
+  0xfb, 0x3e, 0x4e, 0x9f, 0x96, 0x08, 0x81, 0x3f, 0xff, 0xc4, 0x96, 0x3a, 0xf2, 0xc9, 0x47, 0x1f,
+  0x79, 0xba, 0x50, 0x4b, 0x98, 0xc0, 0xe0, 0xa5, 0x57, 0xa9, 0xdd, 0x68, 0xe3, 0xe8, 0x67, 0x03,
+  0x46, 0x65, 0x8a, 0xef, 0x9f, 0x99, 0x62, 0xff, 0xc2, 0xa9, 0xe6, 0xd9, 0xc4, 0xd1, 0x2e, 0x9e,
+  0x6a, 0x54, 0xea, 0xe4, 0x3f, 0x63, 0x0e, 0x0f, 0x5e, 0xba, 0x2f, 0x4d, 0xb2, 0xe2, 0x16, 0x50,
+  0x3a, 0x1f, 0xad, 0x5f, 0x0d, 0xdd, 0x57, 0x76, 0xbd, 0xc9, 0xc9, 0xee, 0x93, 0x91, 0x47, 0x78,
+  0xaf, 0xde, 0x90, 0xb1, 0x24, 0xb1, 0x43, 0x0a, 0x36, 0x71, 0x03, 0x44, 0xd3, 0x3d, 0x70, 0xe5,
+  0x52, 0x94, 0x14, 0xa8, 0x0d, 0x42, 0x03, 0x92, 0xa2, 0x33, 0x6a, 0xa3, 0x5c, 0x67, 0x18, 0x3a,
+  0x35, 0x5d, 0xe0, 0xeb, 0x1f, 0x02, 0x1a, 0x07, 0x8f, 0x62, 0xdc, 0xcf, 0x7f, 0xd3, 0x7c, 0x8c,
+  0x53, 0xf3, 0x77, 0xa0, 0xb1, 0xf2, 0x41, 0x03, 0x6a, 0x4a, 0xb5, 0x41, 0x38, 0x67, 0xc5, 0xef,
+  0x28, 0xcd, 0xed, 0xeb, 0x5b, 0x9d, 0xe5, 0xd6, 0xa9, 0xa9, 0xbd, 0x26, 0x36, 0x36, 0x4d, 0xd9,
+  0x8a, 0x7f, 0xa2, 0xa3, 0x9b, 0xd2, 0xfa, 0xe2, 0x47, 0xfd, 0x38, 0x15, 0xca, 0x83, 0xb9, 0x42,
+  0xf5, 0xab, 0x77, 0xff, 0xf1, 0x4c, 0x43, 0xd1, 0xd8, 0x3b, 0x63, 0xb4, 0x31, 0xcf, 0x18, 0xf1,
+  0x77, 0xc0, 0x63, 0x72, 0xe9, 0xc7, 0xd9, 0xc2, 0xc5, 0x44, 0xc0, 0x83, 0xcd, 0xc3, 0x77, 0x0d,
+  0x32, 0x81, 0x58, 0x13, 0x93, 0x46, 0x73, 0x8e, 0x99, 0x7b, 0x87, 0x08, 0x74, 0x66, 0x10, 0x20,
+  0xc9, 0xd6, 0xfc, 0x3e, 0x73, 0xf1, 0xf2, 0xdc, 0xb7, 0x90, 0x58, 0xa4, 0x16, 0xb2, 0xb7, 0xa9,
+  0x61, 0x8d, 0x5b, 0x73, 0xdc, 0xd5, 0xa3, 0x87, 0xbe, 0x49, 0xb2, 0x73, 0xfa, 0x67, 0x51, 0x84,
+  0x59, 0xd2, 0x68, 0x89, 0xce, 0x3b, 0x47, 0x77, 0x3c, 0x74, 0x2c, 0x3b, 0xd5, 0xcf, 0x04, 0xaa,
+  0x70, 0xd5, 0xdf, 0x82, 0xff, 0x6d, 0xc4, 0x81, 0x6b, 0x22, 0x51, 0x48, 0xd5, 0x68, 0xc4, 0xcd,
+  0x83, 0x3a, 0x81, 0x4b, 0xcb, 0x2b, 0x5c, 0x1a, 0x8c, 0xf1, 0x33, 0xd1, 0xda, 0xe2, 0xe8, 0xf2,
+  0xb2, 0xa9, 0x95, 0x65, 0x82, 0x58, 0x2b, 0xf4, 0xac, 0x0e, 0xd9, 0x1e, 0xb8, 0x43, 0x1c, 0x13,
+  0x7a, 0x43, 0x96, 0x49, 0xa3, 0x08, 0xf9, 0x90, 0xc7, 0xe9, 0x17, 0x9c, 0x48, 0x9b, 0x12, 0xff,
+  0xcf, 0x8d, 0x32, 0xe4, 0x5b, 0x4d, 0x6e, 0x63, 0xd2, 0xd2, 0x63, 0xf1, 0x75, 0xf1, 0xea, 0xdd,
+  0x75, 0x4d, 0x96, 0x3c, 0x18, 0xe7, 0x62, 0xcd, 0x5d, 0x3d, 0x12, 0x57, 0xba, 0x9e, 0x0f, 0xff,
+  0xe1, 0x5f, 0x13, 0xf3, 0xd7, 0xfd, 0x53, 0x85, 0xc9, 0x3d, 0xde, 0xd1, 0xb6, 0x6f, 0x3d, 0x6a,
+  0x89, 0x25, 0x3f, 0xda, 0xfb, 0xed, 0x01, 0x75, 0xe5, 0xd8, 0xc6, 0x5d, 0x44, 0x47, 0xc0, 0x99,
+  0x0d, 0x3d, 0x8d, 0x8f, 0xef, 0x3c, 0x00, 0xf6, 0x05, 0x75, 0x78, 0xdd, 0x38, 0x01, 0xec, 0x7f,
+  0x80, 0x71, 0xeb, 0x4c, 0x27, 0xe9, 0x7d, 0xcf, 0x85, 0x44, 0x0f, 0xa9, 0x69, 0x43, 0x9e, 0x55,
+  0xd7, 0x34, 0x6e, 0xed, 0xeb, 0xff, 0x98, 0x7e, 0x05, 0xda, 0x5f, 0x4f, 0xd8, 0x55, 0x9b, 0x9f,
+  0x80, 0x3d, 0xf3, 0x6b, 0xf6, 0xbf, 0xfe, 0x60, 0x6d, 0x53, 0xb2, 0x15, 0x00, 0x00,
+};
@@ -0,0 +1,389 @@
+// Host simulator of the two core ESP32: shared state of the mocks
+// - real-time clock since the start of the simulation
+// - flash cache: an NVS write disables it and stalls all code which runs from flash
+// - scripted events (HTTP requests, IR buttons and faults) with their due time
+// - statistics for the final report
+
+#pragma once
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace sim {
+
+typedef std::chrono::steady_clock Clock;
+
+inline Clock::time_point startTime() {
+  static Clock::time_point start = Clock::now();
+  return start;
+}
+
+/// stalls of the host which are excluded from the simulated time (see HostStalls)
+inline std::atomic<uint64_t> &stalledUs() {
+  static std::atomic<uint64_t> result{0};
+  return result;
+}
+
+/// time of the host since the start in us
+inline uint64_t hostUs() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime()).count();
+}
+
+/// simulated time since the start in us: it stops while a stall is excluded
+inline uint64_t nowUs() {
+  static std::atomic<uint64_t> last{0};
+  uint64_t result = hostUs() - stalledUs();
+  uint64_t old = last.load();
+  while (result > old && !last.compare_exchange_weak(old, result)) {
+  }
+  return result > old ? result : old;
+}
+
+inline void sleepUntilUs(uint64_t us) {
+  // a stall during the sleep moves the end
+  while (nowUs() < us) {
+    std::this_thread::sleep_until(startTime() + std::chrono::microseconds(us + stalledUs()));
+  }
+}
+
+/// busy loop e.g. for an additional load of a core
+inline void spinUs(uint64_t us) {
+  uint64_t end = nowUs() + us;
+  while (nowUs() < end) {
+  }
+}
+
+/// core of the calling thread (see xTaskCreatePinnedToCore)
+inline int &coreId() {
+  static thread_local int core = 1;
+  return core;
+}
+
+// Flash cache: disabled during NVS writes, code running from flash waits until it is enabled again
+class FlashCache {
+ public:
+  void disable() {
+    std::lock_guard<std::mutex> lock(mutex);
+    disabled = true;
+  }
+
+  void enable() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      disabled = false;
+    }
+    changed.notify_all();
+  }
+
+  /// waits while the cache is disabled: returns the waiting time in us
+  uint64_t access() {
+    if (!disabled) return 0;
+    uint64_t start = nowUs();
+    std::unique_lock<std::mutex> lock(mutex);
+    changed.wait(lock, [this] { return !disabled; });
+    return nowUs() - start;
+  }
+
+  /// stalls both cores for the indicated time
+  void stall(uint32_t ms) {
+    disable();
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+    enable();
+    stalls++;
+    if (ms > max_stall_ms) max_stall_ms = ms;
+  }
+
+  std::atomic<int> stalls{0};
+  std::atomic<uint32_t> max_stall_ms{0};
+
+ protected:
+  std::mutex mutex;
+  std::condition_variable changed;
+  std::atomic<bool> disabled{false};
+};
+
+inline FlashCache &flashCache() {
+  static FlashCache cache;
+  return cache;
+}
+
+// Scripted event: "<ms> GET <path> [body]", "<ms> PUT <path> <json>", "<ms> IR <code>",
+// "<ms> STALL <ms>" (flash), "<ms> BUSY <ms>" (core 0) or "<ms> LOAD <ms> <us per block>" (core 1)
+struct Event {
+  uint32_t time_ms = 0;
+  std::string command;
+  std::string path;
+  std::string body;
+  uint32_t value = 0;
+  uint32_t value2 = 0;
+};
+
+class Script {
+ public:
+  bool load(const char *fileName) {
+    FILE *file = fopen(fileName, "r");
+    if (file == nullptr) return false;
+    char line[512];
+    while (fgets(line, sizeof(line), file) != nullptr) {
+      char *comment = strchr(line, '#');
+      if (comment != nullptr) *comment = 0;
+      Event event;
+      char command[16], arg[256];
+      int n = sscanf(line, "%u %15s %255s", &event.time_ms, command, arg);
+      if (n < 2) continue;
+      event.command = command;
+      if (n == 3) event.path = arg;
+      if (event.command == "GET" || event.command == "PUT") {
+        const char *body = strstr(line, arg);
+        body = body != nullptr ? body + strlen(arg) : "";
+        while (*body == ' ' || *body == '\t') body++;
+        event.body = body;
+        while (!event.body.empty() && (event.body.back() == '\n' || event.body.back() == '\r' ||
+                                       event.body.back() == ' '))
+          event.body.pop_back();
+      } else {
+        sscanf(line, "%*u %*s %i %u", &event.value, &event.value2);
+      }
+      add(event);
+    }
+    fclose(file);
+    return true;
+  }
+
+  void add(const Event &event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto pos = events.begin();
+    while (pos != events.end() && pos->time_ms <= event.time_ms) pos++;
+    events.insert(pos, event);
+  }
+
+  /// removes the next due event of one of the commands (separated by |)
+  bool next(const char *commands, Event &event) {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t now_ms = nowUs() / 1000;
+    for (auto it = events.begin(); it != events.end() && it->time_ms <= now_ms; it++) {
+      if (matches(commands, it->command)) {
+        event = *it;
+        events.erase(it);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// true if an event of the commands is due
+  bool pending(const char *commands) {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t now_ms = nowUs() / 1000;
+    for (auto &event : events) {
+      if (event.time_ms > now_ms) break;
+      if (matches(commands, event.command)) return true;
+    }
+    return false;
+  }
+
+ protected:
+  std::mutex mutex;
+  std::deque<Event> events;
+
+  static bool matches(const char *commands, const std::string &command) {
+    std::string list = std::string("|") + commands + "|";
+    return list.find("|" + command + "|") != std::string::npos;
+  }
+};
+
+inline Script &script() {
+  static Script events;
+  return events;
+}
+
+// Options of the command line
+struct Options {
+  const char *input = nullptr;   // wav
+  const char *output = "sim_out.wav";
+  const char *script = nullptr;
+  const char *prefs = "sim_prefs";  // folder of the Preferences files
+  float seconds = 10;            // duration without input file
+  float input_ppm = 0;           // clock deviation of the SPDIF input
+  uint32_t nvs_stall_ms = 0;     // flash stall of each Preferences write
+  bool fail_on_underrun = false;
+  bool fail_on_overrun = false;
+  bool check_ratio = false;      // the ASRC ratio must settle at the input ppm
+  bool fixed_buffers = false;    // no adaptive depth of the output buffers
+};
+
+inline Options &options() {
+  static Options result;
+  return result;
+}
+
+// Statistics for the report
+struct Statistics {
+  std::atomic<uint32_t> underruns{0};        // output deadline misses
+  std::atomic<uint32_t> underrun_frames{0};
+  std::atomic<uint32_t> overruns{0};         // input DMA overflows
+  std::atomic<uint32_t> overrun_frames{0};
+  std::atomic<uint32_t> key_overruns{0};     // key ADC (SIDECHAIN) not drained
+  std::atomic<uint32_t> host_underruns{0};   // during a stall of the host
+  std::atomic<uint32_t> host_overruns{0};
+  std::atomic<int64_t> min_slack_us{INT64_MAX};  // smallest filling of the output at a write
+  std::atomic<uint32_t> blocks{0};
+  std::atomic<uint64_t> max_block_us{0};
+  std::atomic<uint32_t> requests{0};
+  std::atomic<uint64_t> max_request_us{0};
+  std::atomic<uint64_t> flash_wait_us{0};    // time the audio core waited for the flash cache
+  std::mutex mutex;
+  std::vector<float> latency_ms;             // sampled latencyMs() of the sketch
+  std::vector<double> ratio;                 // sampled ratio of the ASRC
+
+  static void maximum(std::atomic<uint64_t> &value, uint64_t sample) {
+    uint64_t old = value.load();
+    while (sample > old && !value.compare_exchange_weak(old, sample)) {
+    }
+  }
+
+  static void minimum(std::atomic<int64_t> &value, int64_t sample) {
+    int64_t old = value.load();
+    while (sample < old && !value.compare_exchange_weak(old, sample)) {
+    }
+  }
+};
+
+inline Statistics &statistics() {
+  static Statistics result;
+  return result;
+}
+
+inline std::atomic<bool> &running() {
+  static std::atomic<bool> result{true};
+  return result;
+}
+
+// Stalls of the host (e.g. a virtual machine with one cpu): a probe thread measures how late it
+// wakes up. With real-time priority it runs first after a stall, which is then excluded from the
+// simulated time: the clocks of the mocks stop like all threads. Otherwise overruns and underruns
+// during a stall are only reported separately, the sketch can not prevent them.
+class HostStalls {
+ public:
+  void probe() {
+    sched_param param;
+    param.sched_priority = sched_get_priority_max(SCHED_FIFO);
+    excluded = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+    while (running()) {
+      uint64_t start = hostUs();
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      uint64_t late = hostUs() - start - 1000;
+      if (late > threshold_us) {
+        if (excluded) stalledUs() += late;
+        uint64_t end = nowUs();
+        std::lock_guard<std::mutex> lock(mutex);
+        windows.push_back({end - (excluded ? 1000 : late + 1000), end});
+        if (windows.size() > 256) windows.pop_front();
+        count++;
+      }
+    }
+  }
+
+  /// true if the stalls are excluded from the simulated time
+  bool isExcluded() { return excluded; }
+
+  /// true if a stall overlaps the time
+  bool during(uint64_t from, uint64_t to) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto &window : windows) {
+      if (window.first < to && window.second > from) return true;
+    }
+    return false;
+  }
+
+  std::atomic<uint32_t> count{0};
+
+ protected:
+  static const uint64_t threshold_us = 2000;
+  std::atomic<bool> excluded{false};
+  std::mutex mutex;
+  std::deque<std::pair<uint64_t, uint64_t>> windows;
+};
+
+inline HostStalls &hostStalls() {
+  static HostStalls stalls;
+  return stalls;
+}
+
+// Minimal wav file with 16 bit PCM
+struct Wav {
+  uint32_t sample_rate = 44100;
+  int channels = 2;
+  std::vector<int16_t> samples;
+
+  bool read(const char *fileName) {
+    FILE *file = fopen(fileName, "rb");
+    if (file == nullptr) return false;
+    char id[4];
+    uint32_t size;
+    bool result = false;
+    if (fread(id, 1, 4, file) == 4 && memcmp(id, "RIFF", 4) == 0 && fread(&size, 4, 1, file) == 1 &&
+        fread(id, 1, 4, file) == 4 && memcmp(id, "WAVE", 4) == 0) {
+      uint16_t format = 0, bits = 0;
+      while (fread(id, 1, 4, file) == 4 && fread(&size, 4, 1, file) == 1) {
+        if (memcmp(id, "fmt ", 4) == 0) {
+          uint8_t fmt[40] = {0};
+          if (fread(fmt, 1, size < 40 ? size : 40, file) < 16) break;
+          if (size > 40) fseek(file, size - 40, SEEK_CUR);
+          memcpy(&format, fmt, 2);
+          uint16_t ch;
+          memcpy(&ch, fmt + 2, 2);
+          channels = ch;
+          memcpy(&sample_rate, fmt + 4, 4);
+          memcpy(&bits, fmt + 14, 2);
+        } else if (memcmp(id, "data", 4) == 0) {
+          if (format != 1 || bits != 16) break;
+          samples.resize(size / 2);
+          samples.resize(fread(samples.data(), 2, samples.size(), file));
+          result = true;
+          break;
+        } else {
+          fseek(file, size + (size & 1), SEEK_CUR);
+        }
+      }
+    }
+    fclose(file);
+    return result;
+  }
+
+  bool write(const char *fileName) {
+    FILE *file = fopen(fileName, "wb");
+    if (file == nullptr) return false;
+    uint32_t data_size = samples.size() * 2;
+    uint32_t riff_size = 36 + data_size;
+    uint16_t format = 1, ch = channels, bits = 16, align = channels * 2;
+    uint32_t fmt_size = 16, byte_rate = sample_rate * align;
+    fwrite("RIFF", 1, 4, file);
+    fwrite(&riff_size, 4, 1, file);
+    fwrite("WAVEfmt ", 1, 8, file);
+    fwrite(&fmt_size, 4, 1, file);
+    fwrite(&format, 2, 1, file);
+    fwrite(&ch, 2, 1, file);
+    fwrite(&sample_rate, 4, 1, file);
+    fwrite(&byte_rate, 4, 1, file);
+    fwrite(&align, 2, 1, file);
+    fwrite(&bits, 2, 1, file);
+    fwrite("data", 1, 4, file);
+    fwrite(&data_size, 4, 1, file);
+    fwrite(samples.data(), 2, samples.size(), file);
+    fclose(file);
+    return true;
+  }
+};
+
+}  // namespace sim
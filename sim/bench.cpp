@@ -0,0 +1,196 @@
+// Cost per block of the effects on the host: each case processes the same synthetic programme
+// (dialogue level noise at -26 dBFS, a burst of 0.9 for 0.5 s every 10 s) in blocks of the sketch.
+// The time is the thread cpu time of processBlock(), the best of the runs is printed per block
+// and per frame. The host says little about the absolute cost on the ESP32, but the ratios of
+// the cases hold. The Compressor is compared with its per-sample path (without the release in
+// closed form below the threshold): speedup and largest difference of the outputs.
+// Usage: compressor_bench [--seconds 60] [--block 256] [--runs 5]
+#include "Arduino.h"
+#include "AudioEffect.h"
+#include <time.h>
+#include <functional>
+#include <memory>
+#include <random>
+
+using namespace audio_tools;
+
+HardwareSerial Serial;
+
+static const float sample_rate = 44100;
+static const int channels = 2;
+
+static uint64_t threadCpuNs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/// stereo programme: band limited noise at dialogue level and a loud burst every 10 s
+static std::vector<int16_t> programme(float seconds) {
+  size_t frames = seconds * sample_rate;
+  std::vector<int16_t> result(frames * channels);
+  std::mt19937 random(26);
+  std::normal_distribution<float> noise(0.0f, 1.0f);
+  float low[channels] = {0.0f};
+  for (size_t j = 0; j < frames; j++) {
+    bool burst = fmodf(j / sample_rate, 10.0f) >= 9.5f;
+    float level = burst ? 0.9f : 0.05f; // -26 dBFS
+    for (int ch = 0; ch < channels; ch++) {
+      low[ch] += 0.2f * (noise(random) - low[ch]);
+      float value = level * (burst ? sinf(j * 0.0627f + ch) : 0.5f * low[ch]);
+      result[j * channels + ch] = (int16_t)(32767.0f * (value > 1.0f ? 1.0f : value < -1.0f ? -1.0f : value));
+    }
+  }
+  return result;
+}
+
+/// the Compressor with the gain of each frame from targetGain() and smoothGain(), as before the
+/// release in closed form: the reference of the speedup
+class PerSampleCompressor : public Compressor {
+ public:
+  using Compressor::Compressor;
+
+  void processBlock(effect_t *data, int frames, int channels) override {
+    const CompressorSettings &act = acquire();
+    float detector[detector_chunk];
+    float input_peak = 0.0f, output_peak = 0.0f, min_gain = 1.0f;
+    for (int start = 0; start < frames; start += detector_chunk) {
+      int count = frames - start < detector_chunk ? frames - start : detector_chunk;
+      effect_t *chunk = data + (start * channels);
+      detect(chunk, count, channels, detector);
+      for (int j = 0; j < count; j++) {
+        float gain = 1.0f - act.mix * (1.0f - smoothGain(act, targetGain(act, detector[j])));
+        lookahead.apply(chunk + (j * channels), channels, gain);
+        if (detector[j] > input_peak) input_peak = detector[j];
+        if (gain * detector[j] > output_peak) output_peak = gain * detector[j];
+        if (gain < min_gain) min_gain = gain;
+      }
+    }
+    block_input = input_peak;
+    block_output = output_peak;
+    block_gain = min_gain;
+  }
+};
+
+typedef std::function<void(effect_t *data, int frames)> Process;
+
+struct Case {
+  const char *name;
+  std::function<Process()> create;  // new effects for each run
+};
+
+/// best cpu time of the runs in ns for all blocks
+static uint64_t measure(const Case &bench, const std::vector<int16_t> &input, int block, int runs) {
+  std::vector<int16_t> buffer(block * channels);
+  size_t frames = input.size() / channels;
+  uint64_t best = UINT64_MAX;
+  for (int run = 0; run < runs; run++) {
+    Process process = bench.create();
+    uint64_t total = 0;
+    for (size_t start = 0; start + block <= frames; start += block) {
+      memcpy(buffer.data(), input.data() + start * channels, buffer.size() * sizeof(int16_t));
+      uint64_t begin = threadCpuNs();
+      process(buffer.data(), block);
+      total += threadCpuNs() - begin;
+    }
+    if (total < best) best = total;
+  }
+  return best;
+}
+
+/// largest difference of the samples (LSB) and of the block gains (dB) of two compressors
+static void difference(Compressor &first, Compressor &second, const std::vector<int16_t> &input, int block,
+                       int &samples, float &gainDb) {
+  std::vector<int16_t> a(block * channels), b(block * channels);
+  size_t frames = input.size() / channels;
+  samples = 0;
+  gainDb = 0.0f;
+  for (size_t start = 0; start + block <= frames; start += block) {
+    memcpy(a.data(), input.data() + start * channels, a.size() * sizeof(int16_t));
+    b = a;
+    first.processBlock(a.data(), block, channels);
+    second.processBlock(b.data(), block, channels);
+    for (size_t j = 0; j < a.size(); j++) samples = std::max(samples, abs(a[j] - b[j]));
+    gainDb = std::max(gainDb, fabsf(first.gainReductionDb() - second.gainReductionDb()));
+  }
+}
+
+/// the effects of the case share their lifetime with the returned function
+template <class... T>
+static Process chain(std::shared_ptr<T>... effects) {
+  return [=](effect_t *data, int frames) {
+    int dummy[] = {(effects->processBlock(data, frames, channels), 0)...};
+    (void)dummy;
+  };
+}
+
+static std::shared_ptr<TruePeakDetector> detector(int block) {
+  return std::make_shared<TruePeakDetector>(true, block, channels);
+}
+
+template <class T = Compressor>
+static std::shared_ptr<T> compressor(TruePeakDetector *p_detector) {
+  auto result = std::make_shared<T>(sample_rate, 10, 500, 0, 30, 4);
+  result->setDetector(p_detector);
+  return result;
+}
+
+static std::shared_ptr<DynamicsProcessor> dynamics(TruePeakDetector *p_detector) {
+  auto result = std::make_shared<DynamicsProcessor>(sample_rate);
+  result->setCompressor(-20, 4);
+  result->setExpander(-50, 2);
+  result->setLimiter(-1);
+  result->setDetector(p_detector);
+  return result;
+}
+
+int main(int argc, char **argv) {
+  float seconds = 60;
+  int block = 256, runs = 5;  // 256 = blocks of the sketch
+  for (int j = 1; j < argc; j++) {
+    std::string arg = argv[j];
+    bool has_value = j + 1 < argc;
+    if (arg == "--seconds" && has_value) seconds = atof(argv[++j]);
+    else if (arg == "--block" && has_value) block = atoi(argv[++j]);
+    else if (arg == "--runs" && has_value) runs = atoi(argv[++j]);
+    else {
+      printf("usage: compressor_bench [--seconds 60] [--block 256] [--runs 5]\n");
+      return 2;
+    }
+  }
+  if (block <= 0 || runs <= 0 || seconds * sample_rate < block) {
+    printf("no complete block\n");
+    return 2;
+  }
+  std::vector<Case> cases = {
+    {"TruePeakDetector", [=]() { return chain(detector(block)); }},
+    {"Compressor", [=]() { return chain(compressor(nullptr)); }},
+    {"Compressor (per-sample path)", [=]() { return chain(compressor<PerSampleCompressor>(nullptr)); }},
+    {"TruePeakDetector + Compressor", [=]() {
+       auto peaks = detector(block);
+       return chain(peaks, compressor(peaks.get()));
+     }},
+    {"DynamicsProcessor", [=]() { return chain(dynamics(nullptr)); }},
+    {"TruePeakDetector + DynamicsProcessor", [=]() {
+       auto peaks = detector(block);
+       return chain(peaks, dynamics(peaks.get()));
+     }},
+  };
+  std::vector<int16_t> input = programme(seconds);
+  size_t blocks = input.size() / channels / block;
+  printf("%.0f s, %zu blocks of %d frames, best of %d runs\n", seconds, blocks, block, runs);
+  printf("%-38s %10s %10s %10s\n", "case", "us/block", "ns/frame", "% of rt");
+  double block_us = 1e6 * block / sample_rate;
+  std::vector<double> ns(cases.size());
+  for (size_t k = 0; k < cases.size(); k++) {
+    ns[k] = measure(cases[k], input, block, runs);
+    double per_block = ns[k] / 1000.0 / blocks;
+    printf("%-38s %10.2f %10.2f %10.3f\n", cases[k].name, per_block, ns[k] / (blocks * block), 100.0 * per_block / block_us);
+  }
+  int samples;
+  float gain_db;
+  difference(*compressor(nullptr), *compressor<PerSampleCompressor>(nullptr), input, block, samples, gain_db);
+  printf("Compressor: %.2fx faster than the per-sample path, outputs differ by at most %d LSB, gains by %.4f dB\n",
+         ns[2] / ns[1], samples, gain_db);
+  return 0;
+}
@@ -0,0 +1,128 @@
+// Test of FastMath.h on the host: the maximum error of each function over its documented range
+// (dense sweep plus random arguments, reference in double) must be within the bound of the
+// documentation. The time per call is compared with the float functions of libm; it is only
+// printed: the host says little about the ESP32.
+// Usage: fastmath_test [--calls n]
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <random>
+#include <vector>
+#include "FastMath.h"
+
+using namespace audio_tools;
+
+struct Check {
+  const char *name;
+  bool relative;
+  double bound;             // documented in FastMath.h
+  double low, high;         // range of the arguments
+  bool logarithmic;         // arguments spaced by factors
+  float (*fast)(float);
+  double (*reference)(double);
+};
+
+static float fastLog2(float x) { return fast_log2(x); }
+static float fastLinearToDb(float x) { return fast_linear_to_db(x); }
+static float fastExp2(float x) { return fast_exp2(x); }
+static float fastDbToLinear(float x) { return fast_db_to_linear(x); }
+static float fastTanh(float x) { return fast_tanh(x); }
+static float fastReciprocal(float x) { return fast_reciprocal(x); }
+
+static double refLinearToDb(double x) { return 20.0 * log10(x); }
+static double refDbToLinear(double x) { return pow(10.0, x / 20.0); }
+static double refReciprocal(double x) { return 1.0 / x; }
+
+static float libLog2(float x) { return log2f(x); }
+static float libLinearToDb(float x) { return 20.0f * log10f(x); }
+static float libExp2(float x) { return exp2f(x); }
+static float libDbToLinear(float x) { return powf(10.0f, x * 0.05f); }
+static float libTanh(float x) { return tanhf(x); }
+static float libReciprocal(float x) { return 1.0f / x; }
+
+static const Check checks[] = {
+  {"fast_log2", false, 1.6e-5, 1e-30, 1e30, true, fastLog2, log2},
+  {"fast_linear_to_db", false, 1.3e-4, 1e-30, 1e30, true, fastLinearToDb, refLinearToDb},
+  {"fast_exp2", true, 2.9e-7, -126, 127, false, fastExp2, exp2},
+  {"fast_db_to_linear", true, 1.4e-6, -120, 120, false, fastDbToLinear, refDbToLinear},
+  {"fast_tanh", false, 9.7e-5, -10, 10, false, fastTanh, tanh},
+  {"fast_reciprocal", true, 6.7e-6, 1e-30, 1e30, true, fastReciprocal, refReciprocal},
+};
+
+static float (*const library[])(float) = {libLog2, libLinearToDb, libExp2, libDbToLinear, libTanh, libReciprocal};
+
+/// arguments: a dense sweep of the range and random values
+static std::vector<float> arguments(const Check &check) {
+  std::vector<float> result;
+  const int sweep = 2000000;
+  double low = check.logarithmic ? log(check.low) : check.low;
+  double high = check.logarithmic ? log(check.high) : check.high;
+  for (int j = 0; j <= sweep; j++) {
+    double value = low + (high - low) * j / sweep;
+    result.push_back(check.logarithmic ? exp(value) : value);
+  }
+  std::mt19937 random(36);
+  std::uniform_real_distribution<double> uniform(low, high);
+  for (int j = 0; j < sweep; j++) {
+    double value = uniform(random);
+    result.push_back(check.logarithmic ? exp(value) : value);
+  }
+  return result;
+}
+
+static double error(const Check &check, float x) {
+  double expected = check.reference(x);
+  double difference = fabs(check.fast(x) - expected);
+  return check.relative ? difference / fabs(expected) : difference;
+}
+
+/// ns per call: the results are summed, so the calls can not be removed
+static double nsPerCall(float (*function)(float), const std::vector<float> &values, int calls, float &sum) {
+  auto start = std::chrono::steady_clock::now();
+  for (int done = 0; done < calls;) {
+    for (size_t j = 0; j < values.size() && done < calls; j++, done++) sum += function(values[j]);
+  }
+  std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+  return duration.count() / calls;
+}
+
+int main(int argc, char **argv) {
+  int calls = 20000000;
+  for (int j = 1; j < argc; j++) {
+    if (strcmp(argv[j], "--calls") == 0 && j + 1 < argc) calls = atoi(argv[++j]);
+    else {
+      printf("usage: fastmath_test [--calls n]\n");
+      return 2;
+    }
+  }
+  int failed = 0;
+  float sum = 0.0f;
+  printf("%-18s %-9s %10s %10s %9s %9s\n", "function", "error", "max", "bound", "ns fast", "ns libm");
+  for (size_t k = 0; k < sizeof(checks) / sizeof(checks[0]); k++) {
+    const Check &check = checks[k];
+    std::vector<float> values = arguments(check);
+    double max_error = 0.0;
+    float worst = 0.0f;
+    for (float x : values) {
+      double value = error(check, x);
+      if (value > max_error) {
+        max_error = value;
+        worst = x;
+      }
+    }
+    double fast_ns = nsPerCall(check.fast, values, calls, sum);
+    double libm_ns = nsPerCall(library[k], values, calls, sum);
+    bool ok = max_error <= check.bound;
+    printf("%-18s %-9s %10.3g %10.3g %9.2f %9.2f%s", check.name, check.relative ? "relative" : "absolute", max_error,
+           check.bound, fast_ns, libm_ns, ok ? "\n" : "");
+    if (!ok) {
+      printf("  FAILED at %.9g\n", worst);
+      failed++;
+    }
+  }
+  if (sum == 1.0f) printf("\n");  // uses the sum
+  printf(failed == 0 ? "all bounds hold\n" : "%d bounds do not hold\n", failed);
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,155 @@
+// Host simulator of Compressor6.ino: the sketch runs unchanged against the mocks.
+// setup() and loop() run on a thread pinned to core 1, the http task on core 0.
+// Usage: compressor_sim [--in in.wav] [--out out.wav] [--script events.txt] [--seconds 10]
+//                       [--nvs-stall-ms 0] [--input-ppm 0] [--prefs folder] [--fail-on-underrun]
+//                       [--fail-on-overrun] [--check-ratio] [--fixed-buffers]
+#include "Arduino.h"
+
+HardwareSerial Serial;
+
+#include "../Compressor6.ino"
+
+static void usage() {
+  printf("usage: compressor_sim [--in in.wav] [--out out.wav] [--script events.txt] [--seconds s]\n"
+         "                      [--nvs-stall-ms ms] [--input-ppm ppm] [--prefs folder] [--fail-on-underrun]\n"
+         "                      [--fail-on-overrun] [--check-ratio] [--fixed-buffers]\n");
+}
+
+static bool parse(int argc, char **argv) {
+  sim::Options &opt = sim::options();
+  for (int j = 1; j < argc; j++) {
+    std::string arg = argv[j];
+    bool has_value = j + 1 < argc;
+    if (arg == "--in" && has_value) opt.input = argv[++j];
+    else if (arg == "--out" && has_value) opt.output = argv[++j];
+    else if (arg == "--script" && has_value) opt.script = argv[++j];
+    else if (arg == "--prefs" && has_value) opt.prefs = argv[++j];
+    else if (arg == "--seconds" && has_value) opt.seconds = atof(argv[++j]);
+    else if (arg == "--nvs-stall-ms" && has_value) opt.nvs_stall_ms = atoi(argv[++j]);
+    else if (arg == "--input-ppm" && has_value) opt.input_ppm = atof(argv[++j]);
+    else if (arg == "--fail-on-underrun") opt.fail_on_underrun = true;
+    else if (arg == "--fail-on-overrun") opt.fail_on_overrun = true;
+    else if (arg == "--check-ratio") opt.check_ratio = true;
+    else if (arg == "--fixed-buffers") opt.fixed_buffers = true;
+    else return false;
+  }
+  return true;
+}
+
+// "<ms> STALL <ms>": e.g. a flash write of another component
+static void faultTask() {
+  while (sim::running()) {
+    sim::Event event;
+    if (sim::script().next("STALL", event)) {
+      Serial.print(("flash stall " + std::to_string(event.value) + " ms\n").c_str());
+      sim::flashCache().stall(event.value);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+// samples the latency which is reported by the sketch
+static void monitorTask() {
+  while (sim::running()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    float value = latencyMs();
+    std::lock_guard<std::mutex> lock(sim::statistics().mutex);
+    sim::statistics().latency_ms.push_back(value);
+#if ASRC && !defined(TEST_GENERATOR)
+    sim::statistics().ratio.push_back(asrc.asrc().ratio());
+#endif
+  }
+}
+
+// the ratio of the ASRC in the last quarter must match the clock of the input: returns false if not
+static bool reportRatio() {
+  std::vector<double> values;
+  {
+    std::lock_guard<std::mutex> lock(sim::statistics().mutex);
+    values = sim::statistics().ratio;
+  }
+  if (values.size() < 4) return !sim::options().check_ratio;
+  double expected = 1.0 + sim::options().input_ppm / 1e6;
+  double low = values.back(), high = low, sum = 0;
+  size_t first = values.size() * 3 / 4;
+  for (size_t j = first; j < values.size(); j++) {
+    low = std::min(low, values[j]);
+    high = std::max(high, values[j]);
+    sum += values[j];
+  }
+  double mean = sum / (values.size() - first);
+  double error_ppm = (mean - expected) * 1e6, spread_ppm = (high - low) * 1e6;
+  printf("asrc ratio in the last quarter: mean %+.1f ppm (input %+.1f ppm), spread %.1f ppm\n", (mean - 1.0) * 1e6,
+         sim::options().input_ppm, spread_ppm);
+  bool settled = fabs(error_ppm) < 20 && spread_ppm < 40;
+  if (sim::options().check_ratio && !settled) printf("ratio did not settle\n");
+  return settled || !sim::options().check_ratio;
+}
+
+static int report(double seconds) {
+  sim::Statistics &stat = sim::statistics();
+  std::vector<float> values;
+  {
+    std::lock_guard<std::mutex> lock(stat.mutex);
+    values = stat.latency_ms;
+  }
+  float lat_min = 0, lat_max = 0, lat_sum = 0;
+  if (!values.empty()) lat_min = lat_max = values[0];
+  for (float value : values) {
+    lat_min = std::min(lat_min, value);
+    lat_max = std::max(lat_max, value);
+    lat_sum += value;
+  }
+  int64_t slack = stat.min_slack_us;
+  printf("\n==> simulation of %.1f s, %u blocks, max block %.2f ms\n", seconds, stat.blocks.load(),
+         stat.max_block_us / 1000.0);
+  printf("output underruns (deadline misses): %u, %u frames silence, min slack %.2f ms\n", stat.underruns.load(),
+         stat.underrun_frames.load(), slack == INT64_MAX ? 0.0 : slack / 1000.0);
+  printf("input overruns: %u, %u frames lost\n", stat.overruns.load(), stat.overrun_frames.load());
+  if (SIDECHAIN) printf("key input overruns: %u, key fallback frames %lu\n", stat.key_overruns.load(),
+                        (unsigned long)compressor.keyFallbackFrames());
+  printf("host stalls: %u%s, during them %u underruns and %u overruns\n", sim::hostStalls().count.load(),
+         sim::hostStalls().isExcluded() ? " (excluded from the time)" : "", stat.host_underruns.load(),
+         stat.host_overruns.load());
+  printf("latency of the sketch: min %.1f avg %.1f max %.1f ms, output buffers %d, loop underruns %lu\n", lat_min,
+         values.empty() ? 0.0f : lat_sum / values.size(), lat_max, latency.bufferCount(),
+         (unsigned long)latency.underrunCount());
+  printf("flash stalls: %d (max %u ms), audio core waited %.1f ms\n", sim::flashCache().stalls.load(),
+         sim::flashCache().max_stall_ms.load(), stat.flash_wait_us / 1000.0);
+  printf("http requests: %u, max %.1f ms; settings commits %lu\n", stat.requests.load(), stat.max_request_us / 1000.0,
+         (unsigned long)persistence.commitCount());
+  bool settled = reportRatio();
+  if (!outputWav().write(sim::options().output)) printf("could not write %s\n", sim::options().output);
+  else printf("output: %s\n", sim::options().output);
+  if (sim::options().fail_on_underrun && stat.underruns > stat.host_underruns) return 1;
+  if (sim::options().fail_on_overrun && stat.overruns > stat.host_overruns) return 1;
+  return settled ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+  if (!parse(argc, argv)) {
+    usage();
+    return 2;
+  }
+  if (sim::options().script != nullptr && !sim::script().load(sim::options().script)) {
+    fprintf(stderr, "could not read %s\n", sim::options().script);
+    return 2;
+  }
+  if (std::thread::hardware_concurrency() < 2) printf("warning: only one cpu, the cores are not pinned\n");
+  sim::startTime();
+  std::thread audio([]() {
+    sim_pin(1);
+    setup();
+    if (sim::options().fixed_buffers) latency.setActive(false);
+    std::thread(faultTask).detach();
+    std::thread(monitorTask).detach();
+    std::thread([]() { sim::hostStalls().probe(); }).detach();
+    while (!inputFinished()) loop();
+  });
+  audio.join();
+  sim::running() = false;
+  int result = report(sim::nowUs() / 1000000.0);
+  fflush(stdout);
+  // the http task runs forever
+  _Exit(result);
+}
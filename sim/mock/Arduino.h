@@ -0,0 +1,112 @@
+// Mock of the Arduino core and FreeRTOS for the host simulator
+#pragma once
+#include <math.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "Sim.h"
+
+#define PROGMEM
+#define HIGH 1
+#define LOW 0
+#define OUTPUT 1
+#define INPUT 0
+#define F(text) text
+#define constrain(value, low, high) ((value) < (low) ? (low) : ((value) > (high) ? (high) : (value)))
+
+using std::max;
+using std::min;
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+inline uint32_t micros() { return (uint32_t)sim::nowUs(); }
+inline uint32_t millis() { return (uint32_t)(sim::nowUs() / 1000); }
+inline void delay(uint32_t ms) { std::this_thread::sleep_for(std::chrono::milliseconds(ms)); }
+inline void delayMicroseconds(uint32_t us) { std::this_thread::sleep_for(std::chrono::microseconds(us)); }
+inline void pinMode(int, int) {}
+inline bool setCpuFrequencyMhz(uint32_t mhz) { return true; }
+inline void digitalWrite(int, int) {}
+
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(const uint8_t *data, size_t len) = 0;
+  virtual size_t write(uint8_t value) { return write(&value, 1); }
+  virtual int availableForWrite() { return 0; }
+  size_t print(const char *text) { return write((const uint8_t *)text, strlen(text)); }
+  size_t print(int value) { return print(std::to_string(value).c_str()); }
+  size_t println(const char *text = "") { return print(text) + print("\n"); }
+  size_t println(int value) { return print(value) + print("\n"); }
+};
+
+class Stream : public Print {
+ public:
+  virtual size_t readBytes(uint8_t *data, size_t len) { return 0; }
+  size_t readBytes(char *data, size_t len) { return readBytes((uint8_t *)data, len); }
+  virtual int available() { return 0; }
+  size_t write(const uint8_t *data, size_t len) override { return len; }
+  using Print::write;
+};
+
+// Serial output with the simulation time
+class HardwareSerial : public Stream {
+ public:
+  void begin(int) {}
+  size_t write(const uint8_t *data, size_t len) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t j = 0; j < len; j++) {
+      if (line_start) printf("[%8.3f] ", sim::nowUs() / 1000000.0);
+      putchar(data[j]);
+      line_start = data[j] == '\n';
+    }
+    fflush(stdout);
+    return len;
+  }
+  using Print::write;
+
+ protected:
+  std::mutex mutex;
+  bool line_start = true;
+};
+
+extern HardwareSerial Serial;
+
+// FreeRTOS: tasks are threads which are pinned to a cpu of the host
+typedef void *TaskHandle_t;
+
+inline void sim_pin(int core) {
+  sim::coreId() = core;
+  int cpus = std::thread::hardware_concurrency();
+  if (cpus < 2) return;
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(core % cpus, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+inline int xTaskCreatePinnedToCore(void (*task)(void *), const char *, uint32_t, void *parameter, int,
+                                   TaskHandle_t *handle, int core) {
+  std::thread thread([=]() {
+    sim_pin(core);
+    task(parameter);
+  });
+  if (handle != nullptr) *handle = (TaskHandle_t)(uintptr_t)thread.native_handle();
+  thread.detach();
+  return 1;
+}
+
+inline int xPortGetCoreID() { return sim::coreId(); }
+
+// PSRAM of the ESP32-WROVER
+inline bool psramFound() { return true; }
+inline void *ps_malloc(size_t size) { return malloc(size); }
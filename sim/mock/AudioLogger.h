@@ -0,0 +1,9 @@
+// Mock of the audio-tools logger for the host simulator: logging is off
+#pragma once
+#include "Arduino.h"
+#define LOGD(...)
+#define LOGI(...)
+#define LOGW(...)
+#define LOGE(...)
+#define TRACED()
+#define TRACEI()
@@ -0,0 +1,36 @@
+// Mock of the audio-tools parameters for the host simulator
+#pragma once
+#include "Arduino.h"
+
+namespace audio_tools {
+
+class VolumeSupport {
+ public:
+  float volume() { return value; }
+  bool setVolume(float volume) {
+    value = volume;
+    return true;
+  }
+
+ protected:
+  float value = 1.0f;
+};
+
+class ADSR {
+ public:
+  ADSR(float attack, float decay, float sustain, float release) {}
+  float tick() { return 1.0f; }
+  void setAttackRate(float) {}
+  float attackRate() { return 0; }
+  void setDecayRate(float) {}
+  float decayRate() { return 0; }
+  void setSustainLevel(float) {}
+  float sustainLevel() { return 0; }
+  void setReleaseRate(float) {}
+  float releaseRate() { return 0; }
+  void keyOn(float) {}
+  void keyOff() {}
+  bool isActive() { return true; }
+};
+
+}  // namespace audio_tools
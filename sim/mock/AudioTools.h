@@ -0,0 +1,272 @@
+// Mock of audio-tools for the host simulator
+// - I2SStream (RX) provides the frames of the input wav at real-time pace: a reader which
+//   is too late loses the oldest frames like the DMA of the device (overrun). As on the device
+//   available() reports the size of a DMA buffer, not their filling
+// - I2SStream (RXTX) reads a silent key ADC with the clock of the output (SIDECHAIN)
+// - I2SStream (TX) and SPDIFOutput play at real-time pace into the output wav: the DMA buffers
+//   are prefilled with silence, a write blocks while they are full and a late write is an underrun
+// - StreamCopy is the block loop of the audio core: it waits while the flash cache is disabled
+//   and applies the LOAD faults of the script
+#pragma once
+#include "Arduino.h"
+#include "AudioEffects.h"
+
+#define DEFAULT_BUFFER_SIZE 1024
+
+namespace audio_tools {
+
+enum RxTxMode { TX_MODE, RX_MODE, RXTX_MODE };
+enum I2SFormat { I2S_STD_FORMAT, I2S_LSB_FORMAT, I2S_MSB_FORMAT };
+
+struct I2SConfig : public AudioInfo {
+  RxTxMode rx_tx_mode = TX_MODE;
+  I2SFormat i2s_format = I2S_STD_FORMAT;
+  bool is_master = true;
+  int port_no = 0;
+  int pin_data = -1, pin_bck = -1, pin_ws = -1, pin_data_rx = -1;
+  int buffer_size = 512;
+  int buffer_count = 6;
+};
+
+/// wav output of the simulation
+inline sim::Wav &outputWav() {
+  static sim::Wav wav;
+  return wav;
+}
+
+/// set when the input wav is played completely
+inline std::atomic<bool> &inputFinished() {
+  static std::atomic<bool> result{false};
+  return result;
+}
+
+// Input DMA which is filled by the clock of the source
+class SimInput {
+ public:
+  /// key = silent ADC with the clock of the output
+  void begin(I2SConfig cfg, bool key = false) {
+    info = cfg;
+    is_key = key;
+    frame_size = cfg.channels * sizeof(int16_t);
+    capacity = cfg.buffer_size * cfg.buffer_count / frame_size;
+    rate = cfg.sample_rate * (key ? 1.0 : 1.0 + sim::options().input_ppm / 1e6);
+    if (key) {
+      source.channels = cfg.channels;
+      source.samples.clear();
+    } else if (sim::options().input != nullptr) {
+      if (!source.read(sim::options().input)) {
+        fprintf(stderr, "could not read %s: 16 bit PCM wav expected\n", sim::options().input);
+        exit(2);
+      }
+      if (source.sample_rate != (uint32_t)cfg.sample_rate)
+        fprintf(stderr, "warning: %s has %u Hz, played as %d Hz\n", sim::options().input, source.sample_rate,
+                cfg.sample_rate);
+    } else {
+      generate(cfg);
+    }
+    start_us = sim::nowUs();
+    consumed = 0;
+  }
+
+  /// like the I2S driver of the device: the size of a DMA buffer, not the received frames
+  int available() { return info.buffer_size; }
+
+  /// blocks until the frames were received
+  size_t readBytes(uint8_t *data, size_t len) {
+    int64_t frames = len / frame_size;
+    if (frames == 0) return 0;
+    // frames are only lost while nobody reads: a waiting reader takes each DMA buffer when it is full
+    backlog(sim::nowUs());
+    last_read_us = sim::nowUs();
+    sim::sleepUntilUs(start_us + (uint64_t)((consumed + frames) * 1e6 / rate));
+    int16_t *samples = (int16_t *)data;
+    int source_channels = source.channels;
+    int64_t total = source.samples.size() / source_channels;
+    for (int64_t j = 0; j < frames; j++, consumed++) {
+      for (int ch = 0; ch < info.channels; ch++) {
+        samples[j * info.channels + ch] =
+            consumed < total ? source.samples[consumed * source_channels + ch % source_channels] : 0;
+      }
+    }
+    if (consumed >= total && !is_key) inputFinished() = true;
+    return frames * frame_size;
+  }
+
+ protected:
+  I2SConfig info;
+  sim::Wav source;
+  int frame_size = 4;
+  int64_t capacity = 256;
+  int64_t consumed = 0;
+  double rate = 44100;
+  uint64_t start_us = 0;
+  uint64_t last_read_us = 0;
+  bool is_key = false;
+
+  /// frames in the DMA: older frames are lost
+  int64_t backlog(uint64_t now) {
+    int64_t produced = (int64_t)((now - start_us) * rate / 1e6);
+    int64_t result = produced - consumed;
+    if (result > capacity) {
+      if (is_key) {
+        sim::statistics().key_overruns++;
+      } else {
+        sim::statistics().overruns++;
+        if (sim::hostStalls().during(last_read_us, now)) sim::statistics().host_overruns++;
+        sim::statistics().overrun_frames += result - capacity;
+      }
+      consumed = produced - capacity;
+      result = capacity;
+    }
+    return result;
+  }
+
+  /// test signal: music like bursts of sines with quiet passages and out-of-phase peaks
+  void generate(I2SConfig cfg) {
+    source.sample_rate = cfg.sample_rate;
+    source.channels = 2;
+    int64_t frames = sim::options().seconds * cfg.sample_rate;
+    source.samples.resize(frames * 2);
+    for (int64_t j = 0; j < frames; j++) {
+      float t = (float)j / cfg.sample_rate;
+      int section = (int)(t * 2) % 4;
+      float level = section == 0 ? 0.05f : section == 1 ? 0.8f : section == 2 ? 0.2f : 0.6f;
+      float value = level * (0.7f * sinf(2 * M_PI * 220 * t) + 0.3f * sinf(2 * M_PI * 1760 * t));
+      float side = section == 3 ? value : 0.0f;
+      source.samples[2 * j] = 32767 * (value * 0.7f + side * 0.3f);
+      source.samples[2 * j + 1] = 32767 * (value * 0.7f - side * 0.3f);
+    }
+  }
+};
+
+// Output DMA which is emptied by the clock of the receiver
+class SimOutput {
+ public:
+  void begin(I2SConfig cfg) {
+    info = cfg;
+    frame_size = cfg.channels * sizeof(int16_t);
+    capacity = cfg.buffer_size * cfg.buffer_count / frame_size;
+    sim::Wav &wav = outputWav();
+    wav.sample_rate = cfg.sample_rate;
+    wav.channels = cfg.channels;
+    // the DMA buffers start with silence
+    wav.samples.resize(wav.samples.size() + capacity * cfg.channels);
+    start_us = sim::nowUs();
+    written = capacity;
+    active = true;
+  }
+
+  void end() { active = false; }
+
+  int availableForWrite() {
+    int64_t free = capacity - (written - played(sim::nowUs()));
+    return free > 0 ? free * frame_size : 0;
+  }
+
+  /// blocks while the DMA buffers are full
+  size_t write(const uint8_t *data, size_t len) {
+    if (!active) return 0;
+    int64_t frames = len / frame_size;
+    int64_t queued = written - played(sim::nowUs());
+    sim::Wav &wav = outputWav();
+    if (queued < 0) {
+      // the deadline was missed: the receiver got silence
+      sim::statistics().underruns++;
+      if (sim::hostStalls().during(last_write_us, sim::nowUs())) sim::statistics().host_underruns++;
+      sim::statistics().underrun_frames += -queued;
+      wav.samples.resize(wav.samples.size() - queued * info.channels);
+      written -= queued;
+      queued = 0;
+    }
+    sim::Statistics::minimum(sim::statistics().min_slack_us, queued * 1000000 / info.sample_rate);
+    if (queued + frames > capacity) {
+      sim::sleepUntilUs(start_us + (uint64_t)((written + frames - capacity) * 1e6 / info.sample_rate));
+    }
+    const int16_t *samples = (const int16_t *)data;
+    wav.samples.insert(wav.samples.end(), samples, samples + frames * info.channels);
+    written += frames;
+    last_write_us = sim::nowUs();
+    return frames * frame_size;
+  }
+
+ protected:
+  I2SConfig info;
+  int frame_size = 4;
+  int64_t capacity = 1024;
+  int64_t written = 0;
+  uint64_t start_us = 0;
+  uint64_t last_write_us = 0;
+  bool active = false;
+
+  int64_t played(uint64_t now) { return (int64_t)((now - start_us) * (double)info.sample_rate / 1e6); }
+};
+
+class I2SStream : public Stream {
+ public:
+  I2SConfig defaultConfig(RxTxMode mode = TX_MODE) {
+    I2SConfig result;
+    result.rx_tx_mode = mode;
+    return result;
+  }
+
+  bool begin(I2SConfig cfg) {
+    mode = cfg.rx_tx_mode;
+    if (mode == RX_MODE) input.begin(cfg);
+    else output.begin(cfg);
+    if (mode == RXTX_MODE) input.begin(cfg, true);  // key ADC with the clocks of the output
+    return true;
+  }
+
+  void end() { output.end(); }
+
+  int available() override { return mode != TX_MODE ? input.available() : 0; }
+
+  size_t readBytes(uint8_t *data, size_t len) override { return mode != TX_MODE ? input.readBytes(data, len) : 0; }
+
+  int availableForWrite() override { return mode != RX_MODE ? output.availableForWrite() : 0; }
+
+  size_t write(const uint8_t *data, size_t len) override { return mode != RX_MODE ? output.write(data, len) : 0; }
+  using Print::write;
+
+ protected:
+  RxTxMode mode = TX_MODE;
+  SimInput input;
+  SimOutput output;
+};
+
+// Copies one block from the input to the output on the audio core
+class StreamCopy {
+ public:
+  StreamCopy(Print &to, Stream &from, int bufferSize = DEFAULT_BUFFER_SIZE)
+      : to(to), from(from), buffer(bufferSize) {}
+
+  size_t copy() {
+    // code from flash waits while an NVS write disables the cache
+    sim::statistics().flash_wait_us += sim::flashCache().access();
+    sim::Event event;
+    if (sim::script().next("LOAD", event)) {
+      load_until_us = sim::nowUs() + event.value * 1000ull;
+      load_us = event.value2;
+    }
+    size_t len = from.readBytes(buffer.data(), buffer.size());
+    uint64_t start = sim::nowUs();
+    if (load_us > 0 && start < load_until_us) sim::spinUs(load_us);
+    size_t result = len > 0 ? to.write(buffer.data(), len) : 0;
+    sim::statistics().blocks++;
+    sim::Statistics::maximum(sim::statistics().max_block_us, sim::nowUs() - start);
+    return result;
+  }
+
+  int bufferSize() { return buffer.size(); }
+
+ protected:
+  Print &to;
+  Stream &from;
+  std::vector<uint8_t> buffer;
+  uint64_t load_until_us = 0;
+  uint32_t load_us = 0;
+};
+
+}  // namespace audio_tools
+
+using namespace audio_tools;
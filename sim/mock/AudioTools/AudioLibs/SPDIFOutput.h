@@ -0,0 +1,34 @@
+// Mock of the audio-tools SPDIF output for the host simulator: plays into the output wav
+#pragma once
+#include "AudioTools.h"
+
+namespace audio_tools {
+
+typedef I2SConfig SPDIFConfig;
+
+class SPDIFOutput : public Print {
+ public:
+  SPDIFConfig defaultConfig() {
+    SPDIFConfig result;
+    result.buffer_size = 384;
+    result.buffer_count = 30;
+    return result;
+  }
+
+  bool begin(SPDIFConfig cfg) {
+    output.begin(cfg);
+    return true;
+  }
+
+  void end() { output.end(); }
+
+  int availableForWrite() override { return output.availableForWrite(); }
+
+  size_t write(const uint8_t *data, size_t len) override { return output.write(data, len); }
+  using Print::write;
+
+ protected:
+  SimOutput output;
+};
+
+}  // namespace audio_tools
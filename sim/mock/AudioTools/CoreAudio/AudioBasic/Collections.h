@@ -0,0 +1,14 @@
+// Mock of the audio-tools collections for the host simulator
+#pragma once
+#include "Arduino.h"
+
+namespace audio_tools {
+
+template <class T>
+class Vector : public std::vector<T> {
+ public:
+  Vector() = default;
+  Vector(size_t size) : std::vector<T>(size) {}
+};
+
+}  // namespace audio_tools
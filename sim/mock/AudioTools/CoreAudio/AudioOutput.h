@@ -0,0 +1,3 @@
+// Mock of the audio-tools outputs for the host simulator
+#pragma once
+#include "AudioTools/CoreAudio/AudioTypes.h"
@@ -0,0 +1,17 @@
+// Mock of the audio-tools streams for the host simulator
+#pragma once
+#include "AudioTools/CoreAudio/AudioTypes.h"
+
+namespace audio_tools {
+
+class ModifyingStream : public Stream {
+ public:
+  virtual void setStream(Stream &io) = 0;
+  virtual void setOutput(Print &out) = 0;
+  virtual void end() {}
+
+ protected:
+  AudioInfo info;
+};
+
+}  // namespace audio_tools
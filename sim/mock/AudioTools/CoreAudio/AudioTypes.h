@@ -0,0 +1,21 @@
+// Mock of the audio-tools types for the host simulator
+#pragma once
+#include "Arduino.h"
+
+namespace audio_tools {
+
+struct AudioInfo {
+  AudioInfo() = default;
+  AudioInfo(int sampleRate, int channelCount, int bitsPerSample)
+      : sample_rate(sampleRate), channels(channelCount), bits_per_sample(bitsPerSample) {}
+  void copyFrom(AudioInfo info) {
+    sample_rate = info.sample_rate;
+    channels = info.channels;
+    bits_per_sample = info.bits_per_sample;
+  }
+  int sample_rate = 44100;
+  int channels = 2;
+  int bits_per_sample = 16;
+};
+
+}  // namespace audio_tools
@@ -0,0 +1,136 @@
+// Mock of TinyHttp for the host simulator: the requests come from the script
+// ("<ms> GET <path> [Header: value]" or "<ms> PUT <path> <json>") and are dispatched
+// to the registered callbacks by copy() on core 0. The responses are logged.
+#pragma once
+#include "Arduino.h"
+#include <map>
+
+enum TinyMethodID { T_GET, T_PUT, T_POST, T_DELETE };
+enum HttpLogLevel { Debug, Info, Warning, Error };
+
+class HttpRequestHandlerLine {};
+
+struct HttpLoggerClass {
+  void begin(Print &, HttpLogLevel) {}
+};
+static HttpLoggerClass HttpLogger;
+
+class WiFiClient : public Stream {
+ public:
+  size_t write(const uint8_t *data, size_t len) override {
+    response.append((const char *)data, len);
+    return len;
+  }
+  using Print::write;
+
+  size_t readBytes(uint8_t *data, size_t len) override {
+    size_t result = std::min(len, request_body.size() - read_pos);
+    memcpy(data, request_body.data() + read_pos, result);
+    read_pos += result;
+    return result;
+  }
+  using Stream::readBytes;
+
+  int available() override { return request_body.size() - read_pos; }
+
+  void setRequest(const std::string &body) {
+    request_body = body;
+    read_pos = 0;
+    response.clear();
+  }
+
+  std::string response;
+
+ protected:
+  std::string request_body;
+  size_t read_pos = 0;
+};
+
+class WiFiServer {
+ public:
+  /// another request is waiting
+  bool hasClient() { return sim::script().pending("GET|PUT"); }
+};
+
+class HttpRequestHeader {
+ public:
+  const char *get(const char *name) {
+    auto it = values.find(name);
+    return it == values.end() ? nullptr : it->second.c_str();
+  }
+  std::map<std::string, std::string> values;
+};
+
+class HttpServer;
+typedef void (*web_callback_fn)(HttpServer *server, const char *requestPath, HttpRequestHandlerLine *handlerLine);
+
+class HttpServer {
+ public:
+  HttpServer(WiFiServer &server) {}
+
+  void on(const char *url, TinyMethodID method, web_callback_fn fn) { handlers[key(method, url)] = fn; }
+
+  bool begin(int port, const char *ssid, const char *password) { return true; }
+
+  void setTimeout(int ms) {}
+
+  /// processes the due requests of the script
+  bool copy() {
+    sim::Event event;
+    if (sim::script().next("BUSY", event)) {
+      // e.g. the WiFi stack: core 0 is not available for the http task
+      sim::spinUs(event.value * 1000ull);
+    }
+    if (!sim::script().next("GET|PUT", event)) return false;
+    TinyMethodID method = event.command == "PUT" ? T_PUT : T_GET;
+    header.values.clear();
+    if (method == T_PUT) {
+      header.values["Content-Length"] = std::to_string(event.body.size());
+      http_client.setRequest(event.body);
+    } else {
+      size_t pos = event.body.find(':');
+      if (pos != std::string::npos) {
+        size_t start = event.body.find_first_not_of(' ', pos + 1);
+        header.values[event.body.substr(0, pos)] = start == std::string::npos ? "" : event.body.substr(start);
+      }
+      http_client.setRequest("");
+    }
+    auto it = handlers.find(key(method, event.path.c_str()));
+    uint64_t start = sim::nowUs();
+    if (it != handlers.end()) {
+      HttpRequestHandlerLine line;
+      it->second(this, event.path.c_str(), &line);
+    } else {
+      http_client.print("HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n");
+    }
+    uint64_t duration = sim::nowUs() - start;
+    sim::statistics().requests++;
+    sim::Statistics::maximum(sim::statistics().max_request_us, duration);
+    log(event, duration);
+    return true;
+  }
+
+  HttpRequestHeader &requestHeader() { return header; }
+
+  WiFiClient &client() { return http_client; }
+
+ protected:
+  std::map<std::string, web_callback_fn> handlers;
+  HttpRequestHeader header;
+  WiFiClient http_client;
+
+  static std::string key(TinyMethodID method, const char *url) { return std::to_string(method) + url; }
+
+  void log(const sim::Event &event, uint64_t duration) {
+    const std::string &response = http_client.response;
+    size_t end = response.find("\r\n\r\n");
+    std::string status = response.substr(9, 3);
+    std::string body = end == std::string::npos ? "" : response.substr(end + 4);
+    bool text = response.find("application/json") != std::string::npos;
+    char msg[400];
+    snprintf(msg, sizeof(msg), "HTTP %s %s -> %s, %u bytes in %.1f ms %s%.160s\n", event.command.c_str(),
+             event.path.c_str(), status.c_str(), (unsigned)body.size(), duration / 1000.0, text ? ": " : "",
+             text ? body.c_str() : "");
+    Serial.print(msg);
+  }
+};
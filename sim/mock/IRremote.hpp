@@ -0,0 +1,41 @@
+// Mock of Arduino-IRremote for the host simulator: "<ms> IR <command>" presses a button
+#pragma once
+#include "Arduino.h"
+
+#define STR_HELPER(x) #x
+#define STR(x) STR_HELPER(x)
+#define DISABLE_LED_FEEDBACK false
+#define IRDATA_FLAGS_IS_REPEAT 0x01
+
+enum decode_type_t { UNKNOWN = 0, NEC = 8 };
+
+struct IRData {
+  decode_type_t protocol = UNKNOWN;
+  uint16_t command = 0;
+  uint8_t flags = 0;
+};
+
+class IRrecv {
+ public:
+  void begin(int pin, bool feedback) {}
+
+  bool decode() {
+    sim::Event event;
+    if (!sim::script().next("IR", event)) return false;
+    decodedIRData.protocol = NEC;
+    decodedIRData.command = event.value;
+    decodedIRData.flags = 0;
+    Serial.print((std::string("IR command ") + std::to_string(event.value) + "\n").c_str());
+    return true;
+  }
+
+  void resume() {}
+
+  void printIRResultRawFormatted(Print *, bool) {}
+
+  IRData decodedIRData;
+};
+
+static IRrecv IrReceiver;
+
+inline void printActiveIRProtocols(Print *out) { out->print("NEC (simulated) "); }
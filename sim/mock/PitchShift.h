@@ -0,0 +1,16 @@
+// Mock of the audio-tools pitch shift for the host simulator
+#pragma once
+#include "AudioTools/CoreAudio/AudioBasic/Collections.h"
+
+namespace audio_tools {
+
+template <class T>
+class VariableSpeedRingBuffer {
+ public:
+  void resize(int size) {}
+  void setIncrement(float increment) {}
+  void write(T sample) {}
+  T read() { return 0; }
+};
+
+}  // namespace audio_tools
@@ -0,0 +1,54 @@
+// Mock of the ESP32 Preferences: each key is a file in the folder of --prefs.
+// Each write disables the flash cache for --nvs-stall-ms like an NVS write on the device.
+#pragma once
+#include "Arduino.h"
+#include <sys/stat.h>
+
+class Preferences {
+ public:
+  bool begin(const char *name, bool readOnly) {
+    mkdir(sim::options().prefs, 0755);
+    path = std::string(sim::options().prefs) + "/" + name;
+    mkdir(path.c_str(), 0755);
+    return true;
+  }
+
+  void end() {}
+
+  size_t putBytes(const char *key, const void *data, size_t len) {
+    if (sim::options().nvs_stall_ms > 0) sim::flashCache().stall(sim::options().nvs_stall_ms);
+    FILE *file = fopen(fileName(key).c_str(), "wb");
+    if (file == nullptr) return 0;
+    size_t result = fwrite(data, 1, len, file);
+    fclose(file);
+    return result;
+  }
+
+  size_t getBytesLength(const char *key) {
+    struct stat info;
+    return stat(fileName(key).c_str(), &info) == 0 ? info.st_size : 0;
+  }
+
+  size_t getBytes(const char *key, void *data, size_t len) {
+    FILE *file = fopen(fileName(key).c_str(), "rb");
+    if (file == nullptr) return 0;
+    size_t result = fread(data, 1, len, file);
+    fclose(file);
+    return result;
+  }
+
+  uint8_t getUChar(const char *key, uint8_t value) {
+    getBytes(key, &value, sizeof(value));
+    return value;
+  }
+
+  uint16_t getUShort(const char *key, uint16_t value) {
+    getBytes(key, &value, sizeof(value));
+    return value;
+  }
+
+ protected:
+  std::string path;
+
+  std::string fileName(const char *key) { return path + "/" + key; }
+};
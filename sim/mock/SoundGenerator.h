@@ -0,0 +1,15 @@
+// Mock of the audio-tools sound generators for the host simulator
+#pragma once
+#include "AudioTools/CoreAudio/AudioTypes.h"
+
+namespace audio_tools {
+
+template <class T>
+class SoundGenerator {
+ public:
+  virtual ~SoundGenerator() {}
+  virtual T readSample() = 0;
+  virtual bool begin(AudioInfo info) { return true; }
+};
+
+}  // namespace audio_tools
@@ -0,0 +1,96 @@
+// Test of Persistence.h and Presets.h on the host with the MemoryBackend: the settings blob
+// survives a round trip, the changes are coalesced into one write, and a corrupt (truncated)
+// blob or a blob of another PRESET_VERSION is rejected, so the sketch keeps its defaults.
+// Usage: persistence_test
+#include "Arduino.h"
+#include "Preferences.h"
+#include "AudioEffect.h"
+
+using namespace audio_tools;
+
+HardwareSerial Serial;
+
+#include "../Persistence.h"
+#include "../Presets.h"
+
+static const float sample_rate = 44100;
+static int failed = 0;
+
+static void check(bool ok, const char *name) {
+  printf("%-44s %s\n", name, ok ? "ok" : "FAILED");
+  if (!ok) failed++;
+}
+
+static bool isDefault(const PresetBlob &blob) {
+  PresetBlob defaults = PresetBlob();  // value-initialized: the padding is zero as well
+  return memcmp(&blob, &defaults, sizeof(PresetBlob)) == 0;
+}
+
+/// changed values in all parts of the blob
+static void change(PresetBlob &blob) {
+  blob.selected = 1;
+  blob.actual = {"actual", 150, 25, 80, 15, 700};
+  blob.autoMin = 20;
+  blob.autoMax = 40;
+  blob.presets[2].threshold = 45;
+}
+
+static void roundTrip() {
+  MemoryBackend backend;
+  PersistenceManager manager(backend, "settings", &presetBlob, sizeof(PresetBlob));
+  presetBlob = PresetBlob();
+  change(presetBlob);
+  PresetBlob expected = presetBlob;
+  // several changes, written once after the silent period
+  manager.markDirty(0);
+  manager.markDirty(500);
+  check(!manager.update(1000, true) && backend.writeCount() == 0, "no write within the silent period");
+  check(manager.update(1500, true) && !manager.isDirty(), "write after the silent period");
+  check(!manager.update(60000, false) && backend.writeCount() == 1, "changes coalesced into one write");
+  presetBlob = PresetBlob();
+  check(Preset_load(backend, sample_rate), "stored blob is loaded");
+  check(memcmp(&presetBlob, &expected, sizeof(PresetBlob)) == 0, "loaded blob equals the stored one");
+}
+
+static void corruptBlob() {
+  MemoryBackend backend;
+  PresetBlob blob;
+  change(blob);
+  backend.write("settings", &blob, sizeof(PresetBlob) - 1);  // truncated
+  presetBlob = PresetBlob();
+  check(!Preset_load(backend, sample_rate) && isDefault(presetBlob), "truncated blob is rejected");
+  MemoryBackend empty;
+  check(!Preset_load(empty, sample_rate) && isDefault(presetBlob), "missing blob is rejected");
+}
+
+static void versionMismatch() {
+  MemoryBackend backend;
+  PresetBlob blob;
+  change(blob);
+  blob.version = PRESET_VERSION - 1;
+  backend.write("settings", &blob, sizeof(PresetBlob));
+  presetBlob = PresetBlob();
+  check(!Preset_load(backend, sample_rate) && isDefault(presetBlob), "blob of another version is rejected");
+}
+
+static void writeError() {
+  MemoryBackend backend;
+  static uint8_t large[MemoryBackend::max_size + 1];
+  PersistenceManager manager(backend, "large", large, sizeof(large));
+  manager.markDirty(0);
+  manager.save();
+  check(!manager.update(0, false) && manager.isDirty(), "failed write stays dirty");
+}
+
+int main(int argc, char **argv) {
+  if (argc > 1) {
+    printf("usage: persistence_test\n");
+    return 2;
+  }
+  roundTrip();
+  corruptBlob();
+  versionMismatch();
+  writeError();
+  printf(failed == 0 ? "all checks passed\n" : "%d checks failed\n", failed);
+  return failed == 0 ? 0 : 1;
+}
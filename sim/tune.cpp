@@ -0,0 +1,429 @@
+// Parameter sweep of the Compressor on the host: ratio, threshold, attack, release (and mix) are
+// evaluated over a corpus of programme audio with the real Compressor and LoudnessMeter classes.
+// Objectives of a point (over all files):
+// - loudness range reduction: LRA (EBU Tech 3342) of the input - LRA of the output in LU (mean)
+// - pumping: maximum rate of the gain reduction between blocks in dB/s (max)
+// - overshoot: output peaks above the static curve of the compressor in dB (max)
+// - cpu: time of processBlock() per frame in ns (mean)
+// The jobs (point x file) run on all cpus with a work-stealing pool. Each result is appended to
+// the cache file at once, so a re-run (e.g. with more points) only evaluates the new points.
+// Delete the cache after changes of the Compressor. --refine adds points between the neighbours
+// of the Pareto front. The front is printed as lines for Presets.h.
+// Usage: compressor_tune [--ratio 2,4,8] [--thresh 20,40] [--attack 5,20] [--release 100,500] [--mix 100]
+//                        [--refine rounds] [--cache tune_cache.csv] [--csv points.csv] [--threads n]
+//                        [--block frames] [--top 20] in1.wav [in2.wav ...]
+#include "Arduino.h"
+#include "AudioEffect.h"
+#include <time.h>
+#include <functional>
+#include <map>
+
+using namespace audio_tools;
+
+HardwareSerial Serial;
+
+struct Point {
+  int ratio, thresh, attack, release, mix;
+
+  std::string key() const {
+    char result[60];
+    snprintf(result, 60, "%d,%d,%d,%d,%d", ratio, thresh, attack, release, mix);
+    return result;
+  }
+};
+
+struct Result {
+  float lra = 0;        // output
+  float max_rate = 0;   // dB/s
+  float overshoot = 0;  // dB
+  float cpu_ns = 0;     // per frame
+};
+
+struct Corpus {
+  std::string name;
+  std::string hash;  // of the samples: the key of the cache
+  sim::Wav wav;
+  float lra = 0;     // input
+};
+
+// Objectives of a point over the corpus
+struct Score {
+  Point point;
+  float lra_reduction = 0, max_rate = 0, overshoot = 0, cpu_ns = 0;
+};
+
+// Thread pool: each thread takes its own jobs from the back of its queue, a thread without jobs
+// steals from the front of the other queues
+class WorkStealingPool {
+ public:
+  explicit WorkStealingPool(int threads) : queues(threads < 1 ? 1 : threads) {}
+
+  void run(const std::vector<std::function<void()>> &jobs) {
+    for (size_t j = 0; j < jobs.size(); j++) queues[j % queues.size()].jobs.push_back(j);
+    std::vector<std::thread> threads;
+    for (size_t j = 0; j < queues.size(); j++) {
+      threads.emplace_back([this, &jobs, j]() {
+        size_t job;
+        while (next(j, job)) jobs[job]();
+      });
+    }
+    for (auto &thread : threads) thread.join();
+  }
+
+ protected:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<size_t> jobs;
+  };
+  std::vector<Queue> queues;
+
+  bool next(size_t self, size_t &job) {
+    for (size_t k = 0; k < queues.size(); k++) {
+      Queue &queue = queues[(self + k) % queues.size()];
+      std::lock_guard<std::mutex> lock(queue.mutex);
+      if (queue.jobs.empty()) continue;
+      if (k == 0) {
+        job = queue.jobs.back();
+        queue.jobs.pop_back();
+      } else {
+        job = queue.jobs.front();
+        queue.jobs.pop_front();
+      }
+      return true;
+    }
+    return false;
+  }
+};
+
+// Results of earlier runs: one line per file and point
+class Cache {
+ public:
+  void load(const char *fileName) {
+    name = fileName;
+    FILE *file = fopen(fileName, "r");
+    if (file == nullptr) return;
+    char line[200], hash[40];
+    Point p;
+    Result r;
+    int block;
+    while (fgets(line, sizeof(line), file) != nullptr) {
+      if (sscanf(line, "%39[^,],%d,%d,%d,%d,%d,%d,%f,%f,%f,%f", hash, &p.ratio, &p.thresh, &p.attack, &p.release,
+                 &p.mix, &block, &r.lra, &r.max_rate, &r.overshoot, &r.cpu_ns) == 11) {
+        results[key(hash, p, block)] = r;
+      }
+    }
+    fclose(file);
+  }
+
+  bool find(const std::string &hash, const Point &p, int block, Result &result) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = results.find(key(hash, p, block));
+    if (it == results.end()) return false;
+    result = it->second;
+    return true;
+  }
+
+  /// appends the result at once: an interrupted run keeps its results
+  void add(const std::string &hash, const Point &p, int block, const Result &r) {
+    std::lock_guard<std::mutex> lock(mutex);
+    results[key(hash, p, block)] = r;
+    FILE *file = fopen(name.c_str(), "a");
+    if (file == nullptr) return;
+    fprintf(file, "%s,%s,%d,%.3f,%.2f,%.3f,%.2f\n", hash.c_str(), p.key().c_str(), block, r.lra, r.max_rate,
+            r.overshoot, r.cpu_ns);
+    fclose(file);
+  }
+
+ protected:
+  std::string name;
+  std::mutex mutex;
+  std::map<std::string, Result> results;
+
+  static std::string key(const std::string &hash, const Point &p, int block) {
+    return hash + "," + p.key() + "," + std::to_string(block);
+  }
+};
+
+static std::vector<int> parseList(const char *text) {
+  std::vector<int> result;
+  for (const char *pos = text; *pos != 0;) {
+    result.push_back(atoi(pos));
+    pos = strchr(pos, ',');
+    if (pos == nullptr) break;
+    pos++;
+  }
+  return result;
+}
+
+static std::string hashSamples(const sim::Wav &wav) {
+  uint64_t hash = 14695981039346656037ull;  // FNV-1a
+  const uint8_t *data = (const uint8_t *)wav.samples.data();
+  for (size_t j = 0; j < wav.samples.size() * 2; j++) hash = (hash ^ data[j]) * 1099511628211ull;
+  hash ^= wav.sample_rate * 31 + wav.channels;
+  char result[20];
+  snprintf(result, 20, "%016llx", (unsigned long long)hash);
+  return result;
+}
+
+static uint64_t threadCpuNs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+/// EBU Tech 3342: short-term loudness values with absolute (-70 LUFS) and relative (-20 LU) gate,
+/// distance of the 10% and the 95% percentile
+static float loudnessRange(std::vector<float> values) {
+  values.erase(std::remove_if(values.begin(), values.end(), [](float v) { return v < -70.0f; }), values.end());
+  if (values.empty()) return 0.0f;
+  double sum = 0.0;
+  for (float v : values) sum += pow(10.0, v / 10.0);
+  float gate = 10.0f * log10(sum / values.size()) - 20.0f;
+  values.erase(std::remove_if(values.begin(), values.end(), [gate](float v) { return v < gate; }), values.end());
+  if (values.empty()) return 0.0f;
+  std::sort(values.begin(), values.end());
+  return values[(size_t)(0.95 * (values.size() - 1))] - values[(size_t)(0.10 * (values.size() - 1))];
+}
+
+/// static output level of the compressor for the normalized input level
+static float staticOutput(const CompressorSettings &s, float input) {
+  if (input <= s.threshold) return input;
+  float gain = (s.threshold + (input - s.threshold) / s.ratio) / input;
+  return input * (1.0f - s.mix * (1.0f - gain));
+}
+
+/// processes the file in blocks: with compressor = nullptr only the loudness range is measured
+static Result process(const Corpus &file, Compressor *compressor, const CompressorSettings &settings, int block) {
+  const sim::Wav &wav = file.wav;
+  int channels = wav.channels;
+  LoudnessMeter meter(wav.sample_rate);
+  std::vector<int16_t> buffer(block * channels);
+  std::vector<float> short_term;
+  Result result;
+  uint64_t cpu_ns = 0;
+  float last_gain = 0.0f;
+  size_t frames = wav.samples.size() / channels;
+  for (size_t start = 0; start < frames; start += block) {
+    int count = frames - start < (size_t)block ? frames - start : block;
+    memcpy(buffer.data(), wav.samples.data() + start * channels, count * channels * sizeof(int16_t));
+    if (compressor != nullptr) {
+      uint64_t begin = threadCpuNs();
+      compressor->processBlock(buffer.data(), count, channels);
+      cpu_ns += threadCpuNs() - begin;
+      float gain = compressor->gainReductionDb();
+      if (start > 0) result.max_rate = std::max(result.max_rate, fabsf(gain - last_gain) * wav.sample_rate / count);
+      last_gain = gain;
+      float steady = staticOutput(settings, compressor->inputPeak());
+      if (steady > 0.0f && compressor->outputPeak() > steady)
+        result.overshoot = std::max(result.overshoot, 20.0f * log10f(compressor->outputPeak() / steady));
+    }
+    meter.processBlock(buffer.data(), count, channels);
+    // one short-term value per 100 ms after the first 3 s
+    if (meter.update() > 0 && start >= 3 * wav.sample_rate) short_term.push_back(meter.shortTerm());
+  }
+  result.lra = loudnessRange(short_term);
+  result.cpu_ns = frames > 0 ? (float)cpu_ns / frames : 0.0f;
+  return result;
+}
+
+static Result evaluate(const Corpus &file, const Point &p, int block) {
+  float sample_rate = file.wav.sample_rate;
+  Compressor compressor(sample_rate, p.attack, p.release, 0, p.thresh, p.ratio);
+  compressor.setMix(p.mix);
+  CompressorSettings settings = Compressor::calculateSettings(sample_rate, p.attack, p.release, p.thresh, p.ratio, p.mix);
+  return process(file, &compressor, settings, block);
+}
+
+static int step(float value, float resolution) { return (int)lroundf(value / resolution); }
+
+/// differences below 0.5 LU, 10 dB/s, 0.5 dB and 20% cpu time (noise of the host) count as equal:
+/// otherwise nearly every point is on the front
+static bool dominates(const Score &a, const Score &b) {
+  int lra_a = step(a.lra_reduction, 0.5f), lra_b = step(b.lra_reduction, 0.5f);
+  int rate_a = step(a.max_rate, 10.0f), rate_b = step(b.max_rate, 10.0f);
+  int over_a = step(a.overshoot, 0.5f), over_b = step(b.overshoot, 0.5f);
+  bool not_worse = lra_a >= lra_b && rate_a <= rate_b && over_a <= over_b && a.cpu_ns <= b.cpu_ns * 1.2f;
+  bool better = lra_a > lra_b || rate_a < rate_b || over_a < over_b || a.cpu_ns * 1.2f < b.cpu_ns;
+  return not_worse && better;
+}
+
+static std::vector<Score> paretoFront(const std::vector<Score> &scores) {
+  std::vector<Score> result;
+  for (const Score &candidate : scores) {
+    bool dominated = false;
+    for (const Score &other : scores) {
+      if (dominates(other, candidate)) {
+        dominated = true;
+        break;
+      }
+    }
+    if (!dominated) result.push_back(candidate);
+  }
+  std::sort(result.begin(), result.end(),
+            [](const Score &a, const Score &b) { return a.lra_reduction > b.lra_reduction; });
+  return result;
+}
+
+/// values between the value and its neighbours in the sorted list
+static void refineValue(std::vector<int> &values, int value, std::vector<int> &result) {
+  auto it = std::find(values.begin(), values.end(), value);
+  if (it == values.end()) return;
+  if (it != values.begin() && value - *(it - 1) > 1) result.push_back((value + *(it - 1)) / 2);
+  if (it + 1 != values.end() && *(it + 1) - value > 1) result.push_back((value + *(it + 1)) / 2);
+}
+
+static void usage() {
+  printf("usage: compressor_tune [--ratio 2,4,8] [--thresh 20,40] [--attack 5,20] [--release 100,500] [--mix 100]\n"
+         "                       [--refine rounds] [--cache tune_cache.csv] [--csv points.csv] [--threads n]\n"
+         "                       [--block frames] [--top 20] in1.wav [in2.wav ...]\n");
+}
+
+int main(int argc, char **argv) {
+  // default grid within the ranges of the web interface
+  std::vector<int> lists[5] = {{2, 4, 8, 20, 50, 100, 200}, {10, 20, 30, 40, 60, 80}, {1, 5, 10, 20, 50},
+                               {50, 100, 200, 500, 1000}, {100}};
+  const char *names[5] = {"--ratio", "--thresh", "--attack", "--release", "--mix"};
+  const char *cache_name = "tune_cache.csv", *csv_name = nullptr;
+  int refine = 0, top = 20, block = 256, threads = std::thread::hardware_concurrency();  // 256 = blocks of the sketch
+  std::vector<Corpus> corpus;
+  for (int j = 1; j < argc; j++) {
+    std::string arg = argv[j];
+    bool has_value = j + 1 < argc, found = false;
+    for (int k = 0; k < 5; k++) {
+      if (arg == names[k] && has_value) {
+        lists[k] = parseList(argv[++j]);
+        found = true;
+      }
+    }
+    if (found) continue;
+    if (arg == "--refine" && has_value) refine = atoi(argv[++j]);
+    else if (arg == "--cache" && has_value) cache_name = argv[++j];
+    else if (arg == "--csv" && has_value) csv_name = argv[++j];
+    else if (arg == "--threads" && has_value) threads = atoi(argv[++j]);
+    else if (arg == "--block" && has_value) block = atoi(argv[++j]);
+    else if (arg == "--top" && has_value) top = atoi(argv[++j]);
+    else if (arg[0] != '-') {
+      corpus.emplace_back();
+      corpus.back().name = arg;
+    } else {
+      usage();
+      return 2;
+    }
+  }
+  if (corpus.empty() || block <= 0) {
+    usage();
+    return 2;
+  }
+  for (Corpus &file : corpus) {
+    if (!file.wav.read(file.name.c_str())) {
+      fprintf(stderr, "could not read %s: 16 bit PCM wav expected\n", file.name.c_str());
+      return 2;
+    }
+    file.hash = hashSamples(file.wav);
+  }
+  WorkStealingPool pool(threads);
+  std::vector<std::function<void()>> jobs;
+  for (Corpus &file : corpus) {
+    jobs.push_back([&file, block]() { file.lra = process(file, nullptr, CompressorSettings(), block).lra; });
+  }
+  pool.run(jobs);
+  for (Corpus &file : corpus) printf("%s: LRA %.1f LU\n", file.name.c_str(), file.lra);
+
+  Cache cache;
+  cache.load(cache_name);
+  std::map<std::string, Point> points;
+  for (int r : lists[0])
+    for (int t : lists[1])
+      for (int a : lists[2])
+        for (int rel : lists[3])
+          for (int m : lists[4]) {
+            Point p = {r, t, a, rel, m};
+            points[p.key()] = p;
+          }
+
+  std::vector<Score> scores, front;
+  for (int round = 0; round <= refine; round++) {
+    // evaluates the points which are not in the cache
+    jobs.clear();
+    std::atomic<int> evaluated{0};
+    for (auto &entry : points) {
+      for (Corpus &file : corpus) {
+        Result result;
+        const Point &p = entry.second;
+        if (cache.find(file.hash, p, block, result)) continue;
+        jobs.push_back([&file, &p, &cache, &evaluated, block]() {
+          cache.add(file.hash, p, block, evaluate(file, p, block));
+          evaluated++;
+        });
+      }
+    }
+    uint64_t start = sim::nowUs();
+    pool.run(jobs);
+    printf("round %d: %zu points, %d evaluated in %.1f s on %d threads\n", round, points.size(), evaluated.load(),
+           (sim::nowUs() - start) / 1e6, threads);
+
+    scores.clear();
+    for (auto &entry : points) {
+      Score score;
+      score.point = entry.second;
+      for (Corpus &file : corpus) {
+        Result result;
+        cache.find(file.hash, entry.second, block, result);
+        score.lra_reduction += (file.lra - result.lra) / corpus.size();
+        score.cpu_ns += result.cpu_ns / corpus.size();
+        score.max_rate = std::max(score.max_rate, result.max_rate);
+        score.overshoot = std::max(score.overshoot, result.overshoot);
+      }
+      scores.push_back(score);
+    }
+    front = paretoFront(scores);
+    if (round == refine) break;
+    // new points: one parameter at a time between a point of the front and its neighbours
+    size_t before = points.size();
+    for (int k = 0; k < 5; k++) std::sort(lists[k].begin(), lists[k].end());
+    std::vector<int> added[5];
+    for (const Score &score : front) {
+      const Point &p = score.point;
+      int values[5] = {p.ratio, p.thresh, p.attack, p.release, p.mix};
+      for (int k = 0; k < 5; k++) {
+        std::vector<int> between;
+        refineValue(lists[k], values[k], between);
+        for (int value : between) {
+          int changed[5] = {values[0], values[1], values[2], values[3], values[4]};
+          changed[k] = value;
+          Point q = {changed[0], changed[1], changed[2], changed[3], changed[4]};
+          points[q.key()] = q;
+          added[k].push_back(value);
+        }
+      }
+    }
+    for (int k = 0; k < 5; k++) lists[k].insert(lists[k].end(), added[k].begin(), added[k].end());
+    if (points.size() == before) break;
+  }
+
+  if (csv_name != nullptr) {
+    FILE *file = fopen(csv_name, "w");
+    if (file != nullptr) {
+      fprintf(file, "ratio,thresh,attack,release,mix,lra_reduction,max_rate,overshoot,cpu_ns,front\n");
+      for (const Score &s : scores) {
+        bool on_front = false;
+        for (const Score &f : front) on_front = on_front || f.point.key() == s.point.key();
+        fprintf(file, "%s,%.2f,%.1f,%.2f,%.2f,%d\n", s.point.key().c_str(), s.lra_reduction, s.max_rate, s.overshoot,
+                s.cpu_ns, on_front);
+      }
+      fclose(file);
+    }
+  }
+  printf("\n==> Pareto front: %zu of %zu points (Presets.h: name, ratio, threshold, mix, attack, release)\n",
+         front.size(), scores.size());
+  // evenly spaced along the loudness range reduction: all points with --csv
+  int count = top < (int)front.size() ? top : front.size(), number = 1;
+  for (int j = 0; j < count; j++) {
+    const Score &s = front[count > 1 ? (size_t)j * (front.size() - 1) / (count - 1) : 0];
+    const Point &p = s.point;
+    printf("    {\"tune%d\", %d, %d, %d, %d, %d},  // LRA -%.1f LU, max %.0f dB/s, overshoot %.1f dB, %.1f ns/frame\n",
+           number++, p.ratio, p.thresh, p.mix, p.attack, p.release, s.lra_reduction, s.max_rate, s.overshoot,
+           s.cpu_ns);
+  }
+  return 0;
+}
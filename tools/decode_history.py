@@ -0,0 +1,79 @@
+#!/usr/bin/env python3
+"""Decodes the gain reduction history of GET /api/history (see History.h).
+
+Usage: python3 tools/decode_history.py <file or http://device/api/history> [--csv out.csv] [--plot]
+
+Without options the records are printed as CSV. --plot needs matplotlib.
+"""
+import struct
+import sys
+import urllib.request
+
+HEADER = struct.Struct("<4sHHIII")
+RECORD = struct.Struct("<Hhhhh")
+NONE = -32768
+
+
+def load(source):
+    if source.startswith("http://") or source.startswith("https://"):
+        with urllib.request.urlopen(source, timeout=30) as response:
+            return response.read()
+    with open(source, "rb") as f:
+        return f.read()
+
+
+def decode(data):
+    magic, version, record_size, sample_rate, first, count = HEADER.unpack_from(data, 0)
+    if magic != b"GRHS" or version != 1 or record_size != RECORD.size:
+        raise ValueError("unsupported history format")
+    count = min(count, (len(data) - HEADER.size) // RECORD.size)
+    rows = []
+    frames_total = 0
+    for j in range(count):
+        frames, inp, out, gain, true_peak = RECORD.unpack_from(data, HEADER.size + j * RECORD.size)
+        rows.append((first + j, frames_total / sample_rate, inp / 100.0, out / 100.0, gain / 100.0,
+                     None if true_peak == NONE else true_peak / 100.0))
+        frames_total += frames
+    return rows
+
+
+def write_csv(rows, f):
+    f.write("record,time_s,input_db,output_db,gain_db,true_peak_db\n")
+    for row in rows:
+        f.write("%d,%.4f,%.2f,%.2f,%.2f,%s\n" % (row[0], row[1], row[2], row[3], row[4],
+                                               "" if row[5] is None else "%.2f" % row[5]))
+
+
+def plot(rows):
+    import matplotlib.pyplot as plt
+    time = [row[1] for row in rows]
+    fig, (levels, gains) = plt.subplots(2, 1, sharex=True)
+    levels.plot(time, [row[2] for row in rows], label="input")
+    levels.plot(time, [row[3] for row in rows], label="output")
+    if any(row[5] is not None for row in rows):
+        levels.plot(time, [row[5] for row in rows], label="true-peak")
+    levels.set_ylabel("dBFS")
+    levels.legend()
+    gains.plot(time, [row[4] for row in rows], color="red")
+    gains.set_ylabel("gain dB")
+    gains.set_xlabel("s")
+    plt.show()
+
+
+def main(args):
+    if not args:
+        print(__doc__)
+        return 1
+    rows = decode(load(args[0]))
+    if "--csv" in args:
+        with open(args[args.index("--csv") + 1], "w") as f:
+            write_csv(rows, f)
+    elif "--plot" not in args:
+        write_csv(rows, sys.stdout)
+    if "--plot" in args:
+        plot(rows)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
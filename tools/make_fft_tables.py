@@ -0,0 +1,34 @@
+#!/usr/bin/env python3
+"""Creates SpectrumTables.h: twiddles and Hann window of the spectrum analyser in flash.
+
+The tables are calculated for 1024 points, smaller FFT sizes use every n-th entry.
+Usage: python3 tools/make_fft_tables.py   (from the sketch folder)
+"""
+import math
+import os
+
+SIZE = 1024
+
+root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+
+
+def table(name, values):
+    lines = []
+    for j in range(0, len(values), 8):
+        lines.append("  " + ", ".join("%.9ff" % v for v in values[j:j + 8]) + ",")
+    return "static const float %s[%d] PROGMEM = {\n%s\n};\n" % (name, len(values), "\n".join(lines))
+
+
+# twiddle e^(-2 pi i k / SIZE) = cos - i sin for k < SIZE / 2
+cos_table = [math.cos(2 * math.pi * k / SIZE) for k in range(SIZE // 2)]
+sin_table = [math.sin(2 * math.pi * k / SIZE) for k in range(SIZE // 2)]
+# periodic Hann window
+window = [0.5 - 0.5 * math.cos(2 * math.pi * n / SIZE) for n in range(SIZE)]
+
+with open(os.path.join(root, "SpectrumTables.h"), "w") as f:
+    f.write("// Generated by tools/make_fft_tables.py - do not edit\n")
+    f.write("// FFT tables for up to %d points: smaller sizes use every n-th entry\n\n" % SIZE)
+    f.write("#define SPECTRUM_TABLE_SIZE %d\n\n" % SIZE)
+    f.write(table("fftCos", cos_table) + "\n")
+    f.write(table("fftSin", sin_table) + "\n")
+    f.write(table("fftWindow", window))
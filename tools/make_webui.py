@@ -0,0 +1,27 @@
+#!/usr/bin/env python3
+"""Creates WebUi.h from web/index.html: the page is stored gzipped in flash.
+
+Usage: python3 tools/make_webui.py   (from the sketch folder)
+"""
+import gzip
+import hashlib
+import os
+
+root = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+with open(os.path.join(root, "web", "index.html"), "rb") as f:
+    html = f.read()
+data = gzip.compress(html, compresslevel=9, mtime=0)
+etag = hashlib.sha1(html).hexdigest()[:12]
+
+lines = []
+for j in range(0, len(data), 16):
+    lines.append("  " + ", ".join("0x%02x" % b for b in data[j:j + 16]) + ",")
+
+with open(os.path.join(root, "WebUi.h"), "w") as f:
+    f.write("// Generated by tools/make_webui.py from web/index.html - do not edit\n")
+    f.write("// Web interface: gzipped html (%d bytes, %d bytes uncompressed)\n\n" % (len(data), len(html)))
+    f.write('#define WEB_UI_ETAG "\\"%s\\""\n' % etag)
+    f.write("const size_t webUiSize = %d;\n" % len(data))
+    f.write("static const uint8_t webUi[] PROGMEM = {\n")
+    f.write("\n".join(lines) + "\n")
+    f.write("};\n")